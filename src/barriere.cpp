@@ -0,0 +1,211 @@
+/**
+ * @file barriere.cpp
+ * @brief Implémentation de la classe OptionBarriere et de la construction de son maillage
+ */
+
+#include "barriere.h" // Pour la déclaration de la classe OptionBarriere
+
+#include <algorithm> // Pour std::lower_bound et std::max
+#include <cmath> // Pour std::exp, std::log, std::pow, std::sqrt et std::nan
+#include <iostream> // Pour std::cout et std::endl
+
+const double PRECISION_DATES = 1e-9; // Écart relatif à T en deçà duquel une date de surveillance est confondue avec un temps du maillage
+
+/**
+ * @brief Constructeur de la classe OptionBarriere
+ * @param call Vrai pour un call, faux pour un put
+ * @param type Barrière haute ou basse
+ * @param barriere Niveau de la barrière
+ * @param K Strike de l'option
+ * @param T Temps terminal de l'option
+ * @param L Borne supérieure du domaine, remplacée par la barrière pour une barrière haute surveillée en continu
+ * @param r Taux d'intérêt du marché
+ * @param sigma Volatilité de l'actif
+ * @param datesSurveillance Dates de surveillance croissantes dans ]0, T], vide pour une surveillance continue
+ */
+OptionBarriere::OptionBarriere(bool call, TypeBarriere type, double barriere, double K, double T, double L, double r, double sigma,
+                               const std::vector<double>& datesSurveillance)
+    : Option(K, T, (type == TypeBarriere::Haute && datesSurveillance.empty()) ? barriere : L, r, sigma), call_(call), type_(type),
+      barriere_(barriere), borneInferieure_((type == TypeBarriere::Basse && datesSurveillance.empty()) ? barriere : 0),
+      datesSurveillance_(datesSurveillance), valide_(true)
+{
+    if (barriere <= 0 || barriere > L)
+    {
+        std::cout << "Erreur : la barrière doit être comprise entre 0 et L" << std::endl;
+        valide_ = false;
+    }
+
+    // surveiller() cherche les dates par dichotomie
+    for (std::size_t k = 0; k < datesSurveillance_.size(); k++)
+    {
+        if (datesSurveillance_[k] <= (k == 0 ? 0 : datesSurveillance_[k-1]) || datesSurveillance_[k] > T)
+        {
+            std::cout << "Erreur : les dates de surveillance doivent être strictement croissantes et comprises dans ]0, T]" << std::endl;
+            valide_ = false;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Annule la tranche au-delà de la barrière si une date de surveillance est comprise dans [t, t + dt)
+ * @param t Temps de la tranche
+ * @param dt Pas de temps qui sépare la tranche de la suivante
+ * @param S Valeurs de l'actif de la tranche
+ * @param tranche Valeurs de la tranche, modifiées en place
+ * @return Vrai si la tranche a été modifiée
+ */
+bool OptionBarriere::surveiller(double t, double dt, const std::vector<double>& S, std::vector<double>& tranche) const
+{
+    // Les intervalles [t - epsilon, t + dt - epsilon) des pas successifs se recouvrent exactement : chaque date est appliquée une
+    // seule fois, au temps du maillage le plus proche par défaut. La date T est appliquée par le payoff
+    double epsilon = PRECISION_DATES * T_;
+    auto date = std::lower_bound(datesSurveillance_.begin(), datesSurveillance_.end(), t - epsilon);
+    if (date == datesSurveillance_.end() || *date >= t + dt - epsilon || *date >= T_ - epsilon)
+    {
+        return false;
+    }
+
+    for (std::size_t j = 0; j < S.size(); j++)
+    {
+        if (desactivee(S[j]))
+        {
+            tranche[j] = 0;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Implémentation de la méthode virtuelle pure payoff
+ * @param S Valeur de l'actif en temps t
+ * @param t Valeur du temps t
+ * @return Payoff de l'option, ou sa valeur aux bords du domaine, pour la valeur de l'actif S au temps t
+ */
+double OptionBarriere::payoff(double S, double t) const
+{
+    if (!valide_)
+        return std::nan("");
+
+    // Sur une barrière surveillée en continu l'option vaut 0. Sinon, le bord S = 0 n'est vivant que pour un put à barrière
+    // haute, et le bord S = L que pour un call à barrière basse, où l'option se comporte comme l'option européenne
+    if (S <= borneInferieure_)
+        return (!call_ && type_ == TypeBarriere::Haute) ? K_ * facteurActualisation(t) : 0;
+    else if (S >= L_)
+        return (call_ && type_ == TypeBarriere::Basse) ? S - K_ * facteurActualisation(t) : 0;
+    else if (t == T_)
+    {
+        // À maturité, l'option est désactivée au-delà de la barrière si T est une date de surveillance
+        bool surveilleeEnT = datesSurveillance_.empty() || datesSurveillance_.back() >= T_ * (1 - PRECISION_DATES);
+        if (surveilleeEnT && desactivee(S))
+            return 0;
+        return std::max(0.0, call_ ? S - K_ : K_ - S);
+    }
+    else
+        return 0;
+}
+
+/**
+ * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+ * @param S Valeur de l'actif en temps t
+ * @param t Valeur du temps t
+ * @return Prix analytique de l'option pour la valeur de l'actif S au temps t
+ */
+double OptionBarriere::prixAnalytique(double S, double t) const
+{
+    // La formule de Reiner et Rubinstein suppose r et sigma constants
+    if (!valide_ || !coefficientsConstants())
+        return std::nan("");
+
+    double tau = T_ - t;
+    if (desactivee(S))
+        return 0;
+    if (tau <= 0 || sigma_ <= 0)
+        return std::max(0.0, call_ ? S - K_ : K_ - S);
+
+    // Surveillance discrète : barrière effective décalée vers l'extérieur, en supposant les dates régulières
+    double H = barriere_;
+    if (!datesSurveillance_.empty())
+    {
+        double decalage = 0.5826 * sigma_ * std::sqrt(T_ / datesSurveillance_.size());
+        H *= std::exp(type_ == TypeBarriere::Haute ? decalage : -decalage);
+    }
+
+    // Termes de Reiner et Rubinstein, avec phi = 1 pour un call et -1 pour un put, eta = 1 pour une barrière basse et -1 pour une haute
+    double phi = call_ ? 1 : -1;
+    double eta = type_ == TypeBarriere::Basse ? 1 : -1;
+    double ecart = sigma_ * std::sqrt(tau);
+    double mu = (r_ - 0.5 * sigma_ * sigma_) / (sigma_ * sigma_);
+    double actualisation = std::exp(-r_ * tau);
+    double x1 = std::log(S / K_) / ecart + (1 + mu) * ecart;
+    double x2 = std::log(S / H) / ecart + (1 + mu) * ecart;
+    double y1 = std::log(H * H / (S * K_)) / ecart + (1 + mu) * ecart;
+    double y2 = std::log(H / S) / ecart + (1 + mu) * ecart;
+    double reflexionS = std::pow(H / S, 2 * (mu + 1));
+    double reflexionK = std::pow(H / S, 2 * mu);
+
+    double A = phi * S * repartitionNormale(phi * x1) - phi * K_ * actualisation * repartitionNormale(phi * (x1 - ecart));
+    double B = phi * S * repartitionNormale(phi * x2) - phi * K_ * actualisation * repartitionNormale(phi * (x2 - ecart));
+    double C = phi * S * reflexionS * repartitionNormale(eta * y1) - phi * K_ * actualisation * reflexionK * repartitionNormale(eta * (y1 - ecart));
+    double D = phi * S * reflexionS * repartitionNormale(eta * y2) - phi * K_ * actualisation * reflexionK * repartitionNormale(eta * (y2 - ecart));
+
+    // Le strike est-il du côté vivant de la barrière
+    bool strikeVivant = type_ == TypeBarriere::Basse ? K_ > H : K_ < H;
+    if (call_ == (type_ == TypeBarriere::Basse))
+    {
+        // Call à barrière basse, put à barrière haute
+        return strikeVivant ? A - C : B - D;
+    }
+
+    // Call à barrière haute, put à barrière basse : rien à payer si le strike est désactivé
+    return strikeVivant ? A - B + C - D : 0;
+}
+
+/**
+ * @brief Construit un maillage adapté à une option à barrière
+ * @param option Option à barrière
+ * @param M Nombre de pas de temps souhaité
+ * @param N Nombre de pas d'espace souhaité
+ * @return Maillage partagé (nullptr si l'option est invalide)
+ */
+std::shared_ptr<const Maillage> maillageBarriere(const OptionBarriere& option, int M, int N)
+{
+    if (!option.estValide())
+    {
+        std::cout << "Erreur : pas de maillage pour une option à barrière invalide" << std::endl;
+        return nullptr;
+    }
+
+    // Surveillance continue : la barrière est un bord du domaine
+    if (!option.estSurveilleeDiscretement())
+    {
+        return std::make_shared<const Maillage>(option.getT(), M, option.getBorneInferieure(), option.getL(), N);
+    }
+
+    // Des dates régulières tombent sur le maillage si M est un multiple de leur nombre
+    int nbDates = option.getDatesSurveillance().size();
+    int MAligne = (M + nbDates - 1) / nbDates * nbDates;
+    std::vector<double> t(MAligne + 1);
+    for (int i = 0; i <= MAligne; i++)
+    {
+        t[i] = i * option.getT() / MAligne;
+    }
+    // i T / M peut différer de T d'un ulp : la condition terminale doit être posée exactement à maturité
+    t[MAligne] = option.getT();
+
+    // Pas d'espace divisant la barrière, le domaine allant jusqu'au premier noeud au-delà de L. Les mailles restent toutes de
+    // largeur dS : le maillage n'a qu'un pas d'espace, (S_N - S_0) / N
+    double H = option.getBarriere();
+    double L = option.getL();
+    int nH = std::max(1, static_cast<int>(std::lround(N * H / L)));
+    double dS = H / nH;
+    int NAligne = static_cast<int>(std::ceil(L / dS - PRECISION_DATES));
+    std::vector<double> S(NAligne + 1);
+    for (int j = 0; j <= NAligne; j++)
+    {
+        S[j] = j * dS;
+    }
+    S[nH] = H;
+
+    return std::make_shared<const Maillage>(t, S);
+}
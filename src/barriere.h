@@ -0,0 +1,163 @@
+/**
+ * @file barriere.h
+ * @brief Déclarations de la classe OptionBarriere, option knock-out dont la barrière borne le domaine de résolution
+ */
+
+#ifndef BARRIERE_H
+#define BARRIERE_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+#include "maillage.h" // Pour la déclaration de la classe Maillage
+
+#include <memory> // Pour std::shared_ptr
+#include <vector> // Pour std::vector
+
+/**
+ * @brief Position de la barrière par rapport au spot
+ */
+enum class TypeBarriere
+{
+    Haute, // Up-and-out : l'option est désactivée si l'actif monte jusqu'à la barrière
+    Basse // Down-and-out : l'option est désactivée si l'actif descend jusqu'à la barrière
+};
+
+/**
+ * @brief Classe concrète représentant un put ou un call knock-out, sans remise
+ *
+ * Surveillée en continu, l'option vaut 0 sur la barrière : la barrière devient le bord du domaine, [0, barrière] pour une
+ * barrière haute et [barrière, L] pour une barrière basse, et la grille ne couvre que la région où l'option est vivante.
+ * Surveillée à des dates discrètes, l'option reste vivante au-delà de la barrière entre deux dates : le domaine est [0, L] et
+ * la tranche est annulée au-delà de la barrière à chaque date (méthode surveiller), la grille devant alors avoir un noeud sur
+ * la barrière (voir maillageBarriere). Les dates de surveillance sont prises en compte par les solveurs dérivés de SchemaTheta,
+ * par SchemaAdaptatif et par CrankNicholsonVolLocale
+ */
+class OptionBarriere : public Option
+{
+    private:
+        bool call_; // Vrai pour un call, faux pour un put
+        TypeBarriere type_; // Barrière haute ou basse
+        double barriere_; // Niveau de la barrière
+        double borneInferieure_; // Borne inférieure du domaine (la barrière basse surveillée en continu, 0 sinon)
+        std::vector<double> datesSurveillance_; // Dates de surveillance croissantes (vide pour une surveillance continue)
+        bool valide_; // Faux si la barrière ou les dates de surveillance sont invalides
+
+        /**
+        * @brief Indique si une valeur de l'actif est au-delà de la barrière (la barrière comprise)
+        * @param S Valeur de l'actif
+        * @return Vrai si l'option est désactivée lorsque l'actif vaut S à une date de surveillance
+        */
+        bool desactivee(double S) const { return type_ == TypeBarriere::Haute ? S >= barriere_ : S <= barriere_; }
+
+    public:
+        /**
+        * @brief Constructeur de la classe OptionBarriere
+        * @param call Vrai pour un call, faux pour un put
+        * @param type Barrière haute ou basse
+        * @param barriere Niveau de la barrière
+        * @param K Strike de l'option
+        * @param T Temps terminal de l'option
+        * @param L Borne supérieure du domaine, remplacée par la barrière pour une barrière haute surveillée en continu
+        * @param r Taux d'intérêt du marché
+        * @param sigma Volatilité de l'actif
+        * @param datesSurveillance Dates de surveillance croissantes dans ]0, T], vide pour une surveillance continue
+        */
+        OptionBarriere(bool call, TypeBarriere type, double barriere, double K, double T, double L, double r, double sigma,
+                       const std::vector<double>& datesSurveillance = {});
+
+        /**
+        * @brief Indique si l'option est bien définie
+        *
+        * Une option invalide (barrière hors de ]0, L], dates de surveillance non strictement croissantes ou hors de ]0, T]) n'a
+        * pas de maillage (maillageBarriere retourne nullptr), et son payoff et son prix analytique sont NaN, de sorte qu'une
+        * résolution ne peut pas donner silencieusement un prix
+        *
+        * @return Vrai si l'option est valide
+        */
+        bool estValide() const { return valide_; }
+
+        /**
+        * @brief Getter du type de l'option
+        * @return Vrai pour un call, faux pour un put
+        */
+        bool estCall() const { return call_; }
+
+        /**
+        * @brief Getter de la position de la barrière
+        * @return Barrière haute ou basse
+        */
+        TypeBarriere getType() const { return type_; }
+
+        /**
+        * @brief Getter du niveau de la barrière
+        * @return Niveau de la barrière
+        */
+        double getBarriere() const { return barriere_; }
+
+        /**
+        * @brief Getter des dates de surveillance
+        * @return Référence constante vers les dates de surveillance (vide pour une surveillance continue)
+        */
+        const std::vector<double>& getDatesSurveillance() const { return datesSurveillance_; }
+
+        /**
+        * @brief Borne inférieure du domaine de l'actif
+        * @return La barrière pour une barrière basse surveillée en continu, 0 sinon
+        */
+        double getBorneInferieure() const override { return borneInferieure_; }
+
+        /**
+        * @brief Indique si l'option a des dates de surveillance
+        * @return Vrai si la surveillance est discrète
+        */
+        bool estSurveilleeDiscretement() const override { return !datesSurveillance_.empty(); }
+
+        /**
+        * @brief Annule la tranche au-delà de la barrière si une date de surveillance est comprise dans [t, t + dt)
+        * @param t Temps de la tranche
+        * @param dt Pas de temps qui sépare la tranche de la suivante
+        * @param S Valeurs de l'actif de la tranche
+        * @param tranche Valeurs de la tranche, modifiées en place
+        * @return Vrai si la tranche a été modifiée
+        */
+        bool surveiller(double t, double dt, const std::vector<double>& S, std::vector<double>& tranche) const override;
+
+        /**
+        * @brief Implémentation de la méthode virtuelle pure payoff
+        * @param S Valeur de l'actif en temps t
+        * @param t Valeur du temps t
+        * @return Payoff de l'option, ou sa valeur aux bords du domaine, pour la valeur de l'actif S au temps t (NaN si l'option est invalide)
+        */
+        double payoff(double S, double t) const override;
+
+        /**
+        * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+        *
+        * Formule de Reiner et Rubinstein, qui ne s'applique qu'à taux et volatilité constants (coefficientsConstants()) : la
+        * réflexion par rapport à la barrière demande un rapport (r - sigma^2 / 2) / sigma^2 constant. Pour une surveillance
+        * discrète à dates régulières, la barrière est décalée de 0.5826 sigma sqrt(dt) vers l'extérieur (correction de Broadie,
+        * Glasserman et Kou)
+        *
+        * @param S Valeur de l'actif en temps t
+        * @param t Valeur du temps t
+        * @return Prix analytique de l'option pour la valeur de l'actif S au temps t (NaN si l'option est invalide ou si ses
+        * coefficients ne sont pas constants)
+        */
+        double prixAnalytique(double S, double t) const override;
+};
+
+/**
+ * @brief Construit un maillage adapté à une option à barrière
+ *
+ * Surveillée en continu, la barrière est un bord du domaine et donc un noeud du maillage. Surveillée à des dates discrètes, le
+ * pas d'espace est choisi pour que la barrière tombe sur un noeud (le domaine est prolongé jusqu'au noeud suivant L) et le
+ * nombre de pas de temps est arrondi au multiple supérieur du nombre de dates, pour que des dates régulières soient des temps du
+ * maillage. Une option invalide n'a pas de maillage
+ *
+ * @param option Option à barrière
+ * @param M Nombre de pas de temps souhaité
+ * @param N Nombre de pas d'espace souhaité
+ * @return Maillage partagé (nullptr si l'option est invalide)
+ */
+std::shared_ptr<const Maillage> maillageBarriere(const OptionBarriere& option, int M, int N);
+
+#endif // BARRIERE_H
@@ -0,0 +1,197 @@
+/**
+ * @file convergence.cpp
+ * @brief Implémentation des outils d'étude de convergence des schémas de différences finies
+ */
+
+#include "convergence.h" // Pour la déclaration de etudeConvergence
+#include "diff_finies.h" // Pour les classes CrankNicholson et Implicite
+
+#include <thread> // Pour std::thread
+#include <atomic> // Pour std::atomic
+#include <chrono> // Pour std::chrono::steady_clock
+#include <cmath> // Pour std::log2, std::log10 et std::nan
+#include <algorithm> // Pour std::min et std::max
+#include <iostream> // Pour std::cout et std::endl
+#include <cstdio> // Pour std::printf
+
+const int FINESSE_REFERENCE = 4; // Rapport entre le nombre de pas d'espace de la référence de l'EDP réduite et celui de la grille la plus fine
+const int REPETITIONS_CHRONO = 3; // Nombre de résolutions chronométrées par grille, dont on garde la plus rapide
+
+/**
+ * @brief Construit une grille uniforme de n+1 points entre 0 et longueur, le dernier point valant exactement longueur
+ * @param n Nombre de pas
+ * @param longueur Borne supérieure de la grille
+ * @return Vecteur des points de la grille
+ */
+static std::vector<double> grilleUniforme(int n, double longueur)
+{
+    std::vector<double> v(n+1);
+    for (int k = 0; k < n; k++)
+    {
+        v[k] = k * longueur / n;
+    }
+    v[n] = longueur;
+    return v;
+}
+
+/**
+ * @brief Résout l'EDP sur une grille de taille donnée
+ * @param option Option à évaluer
+ * @param crankNicholson Vrai pour la méthode de Crank Nicholson sur l'EDP complète, faux pour la méthode Implicite sur l'EDP réduite
+ * @param M Nombre de pas de temps
+ * @param N Nombre de pas d'espace
+ * @return Tranche t = 0 de la solution
+ */
+static std::vector<double> resoudre(const Option& option, bool crankNicholson, int M, int N)
+{
+    std::vector<double> t = grilleUniforme(M, option.getT());
+    std::vector<double> S = grilleUniforme(N, option.getL());
+    if (crankNicholson)
+    {
+        EDPComplete edp(option);
+        return CrankNicholson(edp, S, t).solve()[0];
+    }
+    EDPReduite edp(option);
+    return Implicite(edp, S, t).solve()[0];
+}
+
+/**
+ * @brief Résout l'EDP sur des grilles de plus en plus fines, en parallèle, et mesure l'erreur par rapport à une solution de référence
+ * @param option Option à évaluer
+ * @param crankNicholson Vrai pour la méthode de Crank Nicholson sur l'EDP complète, faux pour la méthode Implicite sur l'EDP réduite
+ * @param nbNiveaux Nombre de niveaux de raffinement
+ * @param nbThreads Nombre de résolutions menées en parallèle
+ * @return Résultats de chaque grille, rangés par M puis par N croissants (vide si l'EDP réduite n'a pas de coefficients constants)
+ */
+std::vector<PointConvergence> etudeConvergence(const Option& option, bool crankNicholson, int nbNiveaux, int nbThreads)
+{
+    // L'EDP réduite n'a pas de solution exacte connue lorsque ses coefficients varient
+    if (!crankNicholson && !option.coefficientsConstants())
+    {
+        std::cout << "Erreur : l'étude de convergence de l'EDP réduite demande des coefficients constants" << std::endl;
+        return {};
+    }
+
+    // Solution de référence de l'EDP réduite au temps 0, sur une grille d'espace dont toutes celles de l'étude sont extraites
+    int NReference = (25 << (nbNiveaux - 1)) * FINESSE_REFERENCE;
+    std::vector<double> reference;
+    if (!crankNicholson)
+    {
+        EDPReduite edp(option);
+        std::vector<double> S = grilleUniforme(NReference, option.getL());
+        std::vector<double> t = {0, option.getT()};
+        reference = NoyauChaleur(edp, S, t).solve(0.0);
+    }
+
+    std::vector<PointConvergence> points(nbNiveaux * nbNiveaux);
+    for (int a = 0; a < nbNiveaux; a++)
+    {
+        for (int b = 0; b < nbNiveaux; b++)
+        {
+            points[a * nbNiveaux + b] = {25 << a, 25 << b, std::nan(""), std::nan(""), std::nan("")};
+        }
+    }
+
+    // Les grilles sont distribuées dynamiquement, en commençant par les plus fines qui sont les plus longues
+    std::atomic<int> prochain(points.size() - 1);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < nbThreads; id++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int k = prochain--; k >= 0; k = prochain--)
+            {
+                PointConvergence& point = points[k];
+                std::vector<double> C = resoudre(option, crankNicholson, point.M, point.N);
+
+                // Erreur maximale au temps 0 sur la zone d'intérêt [K/2, 3K/2]
+                double dS = option.getL() / point.N;
+                point.erreur = 0;
+                for (int j = 0; j <= point.N; j++)
+                {
+                    double S = j * dS;
+                    if (S >= option.getK() / 2 && S <= 1.5 * option.getK())
+                    {
+                        double exact = crankNicholson ? option.prixAnalytique(S, 0) : reference[j * (NReference / point.N)];
+                        point.erreur = std::max(point.erreur, std::abs(C[j] - exact));
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Chaque grille est chronométrée seule : les temps servent à choisir la grille et ne doivent pas dépendre des autres threads
+    for (PointConvergence& point : points)
+    {
+        for (int repetition = 0; repetition < REPETITIONS_CHRONO; repetition++)
+        {
+            auto debut = std::chrono::steady_clock::now();
+            resoudre(option, crankNicholson, point.M, point.N);
+            double duree = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+            point.temps = repetition == 0 ? duree : std::min(point.temps, duree);
+        }
+    }
+
+    // Ordre de convergence observé par rapport à la grille deux fois plus grossière en temps et en espace
+    for (int a = 1; a < nbNiveaux; a++)
+    {
+        for (int b = 1; b < nbNiveaux; b++)
+        {
+            points[a * nbNiveaux + b].ordre = std::log2(points[(a-1) * nbNiveaux + b-1].erreur / points[a * nbNiveaux + b].erreur);
+        }
+    }
+
+    return points;
+}
+
+/**
+ * @brief Recommande la grille la moins coûteuse atteignant une tolérance
+ * @param points Résultats d'une étude de convergence
+ * @param tolerance Erreur maximale tolérée
+ * @return Indice de la grille la plus rapide dont l'erreur est inférieure à la tolérance, ou -1 si aucune ne l'atteint
+ */
+int recommanderGrille(const std::vector<PointConvergence>& points, double tolerance)
+{
+    int meilleur = -1;
+    for (std::size_t k = 0; k < points.size(); k++)
+    {
+        if (points[k].erreur <= tolerance && (meilleur < 0 || points[k].temps < points[meilleur].temps))
+        {
+            meilleur = k;
+        }
+    }
+    return meilleur;
+}
+
+/**
+ * @brief Affiche les résultats d'une étude de convergence et la grille recommandée
+ * @param titre Titre de l'étude (contrat et schéma)
+ * @param points Résultats de l'étude de convergence
+ * @param tolerance Erreur maximale tolérée
+ */
+void afficherConvergence(const std::string& titre, const std::vector<PointConvergence>& points, double tolerance)
+{
+    std::printf("%s\n", titre.c_str());
+    std::printf("%8s %8s %14s %8s %12s %16s\n", "M", "N", "erreur", "ordre", "temps (s)", "temps / chiffre");
+    for (const auto& point : points)
+    {
+        // Coût par chiffre de précision : temps divisé par le nombre de chiffres exacts -log10(erreur)
+        double chiffres = -std::log10(point.erreur);
+        std::printf("%8d %8d %14.6e %8.2f %12.4f %16.4f\n", point.M, point.N, point.erreur, point.ordre, point.temps,
+                    chiffres > 0 ? point.temps / chiffres : std::nan(""));
+    }
+
+    int k = recommanderGrille(points, tolerance);
+    if (k < 0)
+    {
+        std::printf("Aucune grille n'atteint la tolérance %g\n\n", tolerance);
+    }
+    else
+    {
+        std::printf("Grille recommandée pour la tolérance %g : M = %d, N = %d\n\n", tolerance, points[k].M, points[k].N);
+    }
+}
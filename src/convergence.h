@@ -0,0 +1,59 @@
+/**
+ * @file convergence.h
+ * @brief Déclarations des outils d'étude de convergence des schémas de différences finies
+ */
+
+#ifndef CONVERGENCE_H
+#define CONVERGENCE_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+
+#include <vector> // Pour std::vector
+#include <string> // Pour std::string
+
+/**
+ * @brief Structure contenant le résultat d'une résolution pour une taille de grille donnée
+ */
+struct PointConvergence
+{
+    int M; // Nombre de pas de temps
+    int N; // Nombre de pas d'espace
+    double erreur; // Erreur maximale par rapport à la solution de référence au temps 0, autour du strike
+    double temps; // Temps de résolution en secondes, mesuré seul
+    double ordre; // Ordre de convergence observé par rapport à la grille de M et N deux fois plus petits (NaN s'il n'y en a pas)
+};
+
+/**
+ * @brief Résout l'EDP sur des grilles de plus en plus fines, en parallèle, et mesure l'erreur par rapport à une solution de référence
+ *
+ * Toutes les grilles rectangulaires M = 25 * 2^a, N = 25 * 2^b avec a et b inférieurs à nbNiveaux sont résolues, de sorte qu'une
+ * grille plus fine en espace qu'en temps (ou l'inverse) peut être recommandée. L'ordre observé d'une grille est
+ * log2(erreur(M/2, N/2) / erreur(M, N)). La référence est le prix analytique de Black Scholes pour l'EDP complète, et la solution
+ * exacte de l'EDP réduite (NoyauChaleur, sur une grille d'espace plus fine que toutes celles de l'étude) pour l'EDP réduite.
+ * Les erreurs sont calculées en parallèle, puis chaque grille est chronométrée seule, sans autre résolution en cours
+ *
+ * @param option Option à évaluer
+ * @param crankNicholson Vrai pour la méthode de Crank Nicholson sur l'EDP complète, faux pour la méthode Implicite sur l'EDP réduite
+ * @param nbNiveaux Nombre de niveaux de raffinement
+ * @param nbThreads Nombre de résolutions menées en parallèle
+ * @return Résultats de chaque grille, rangés par M puis par N croissants (vide si l'EDP réduite n'a pas de coefficients constants)
+ */
+std::vector<PointConvergence> etudeConvergence(const Option& option, bool crankNicholson, int nbNiveaux, int nbThreads);
+
+/**
+ * @brief Recommande la grille la moins coûteuse atteignant une tolérance
+ * @param points Résultats d'une étude de convergence
+ * @param tolerance Erreur maximale tolérée
+ * @return Indice de la grille la plus rapide dont l'erreur est inférieure à la tolérance, ou -1 si aucune ne l'atteint
+ */
+int recommanderGrille(const std::vector<PointConvergence>& points, double tolerance);
+
+/**
+ * @brief Affiche les résultats d'une étude de convergence et la grille recommandée
+ * @param titre Titre de l'étude (contrat et schéma)
+ * @param points Résultats de l'étude de convergence
+ * @param tolerance Erreur maximale tolérée
+ */
+void afficherConvergence(const std::string& titre, const std::vector<PointConvergence>& points, double tolerance);
+
+#endif // CONVERGENCE_H
@@ -1,9 +1,14 @@
 /**
  * @file diff_finies.cpp
- * @brief Implémentation de la classe abstraite DifferencesFinies et de ses classes concrètes CrankNicholson et Implicite
+ * @brief Implémentation de la classe abstraite DifferencesFinies et de ses classes concrètes SchemaTheta, CrankNicholson, Implicite, SchemaAdaptatif, NoyauChaleur et CrankNicholsonVolLocale
  */
 
 #include "diff_finies.h" // Pour la déclaration de la classe DifferencesFinies
+#include "fft.h" // Pour la transformée de Fourier rapide utilisée par NoyauChaleur
+#include "trace.h" // Pour les zones de trace des résolutions
+
+#include <cmath> // Pour std::ldexp et std::nan
+#include <algorithm> // Pour std::reverse
 
 /**
  * @brief Méthode qui résout un système linéaire de la forme A * sol = b en utilisant l'algorithme de Thomas
@@ -11,16 +16,18 @@
  * @param y Vecteur représentant la diagonale de la matrice
  * @param z Vecteur représentant la sur-diagonale de la matrice
  * @param b Vecteur du système linéaire
+ * @param memoire Ressource mémoire dans laquelle sont alloués les vecteurs temporaires de l'algorithme
  * @return Vecteur solution sol du système linéaire
  */
-std::vector<double> algoThomas(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::vector<double>& b)
+std::vector<double> algoThomas(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::vector<double>& b,
+                               std::pmr::memory_resource* memoire)
 {
     // Taille du système
     int n = b.size();
 
     // Vecteurs temporaires utilisés par l'algorithme de Thomas
-    std::vector<double> c(n);
-    std::vector<double> d(n);
+    std::pmr::vector<double> c(n, memoire);
+    std::pmr::vector<double> d(n, memoire);
 
     // On effectue la décomposition LU de la matrice A en utilisant l'algorithme de Thomas
     c[0] = z[0] / y[0];
@@ -44,19 +51,551 @@ std::vector<double> algoThomas(const std::vector<double>& x, const std::vector<d
     return sol;
 }
 
+/**
+ * @brief Méthode qui résout un système linéaire A * sol = b à partir de la décomposition LU de A
+ * @param f Décomposition LU de la matrice A
+ * @param b Vecteur du système linéaire
+ * @param sol Vecteur dans lequel on écrit la solution du système linéaire
+ */
+void resoudreThomas(const FactorisationThomas& f, const std::pmr::vector<double>& b, std::pmr::vector<double>& sol)
+{
+    // Taille du système
+    int n = b.size();
+
+    // Descente : on stocke d directement dans sol
+    sol[0] = b[0] * f.m[0];
+    for (int i = 1; i < n; i++)
+    {
+        sol[i] = (b[i] - f.x[i] * sol[i-1]) * f.m[i];
+    }
+
+    // Remontée
+    for (int i = n-2; i >= 0; i--)
+    {
+        sol[i] -= f.c[i] * sol[i+1];
+    }
+}
+
+/**
+ * @brief Méthode qui résout en place les systèmes A * sol_p = b_p d'un bloc de seconds membres entrelacés
+ * @param f Décomposition LU de la matrice A
+ * @param nb Nombre de seconds membres
+ * @param bloc Seconds membres entrelacés (coefficient j du second membre p en bloc[j * nb + p]), remplacés par les solutions
+ */
+void resoudreThomasBloc(const FactorisationThomas& f, int nb, double* bloc)
+{
+    // Taille du système
+    int n = f.m.size();
+
+    // Descente : la chaîne de dépendance est en j, les nb seconds membres d'une même ligne sont indépendants
+    for (int p = 0; p < nb; p++)
+    {
+        bloc[p] *= f.m[0];
+    }
+    for (int i = 1; i < n; i++)
+    {
+        double x = f.x[i];
+        double m = f.m[i];
+        double* ligne = bloc + i * nb;
+        const double* precedente = ligne - nb;
+        for (int p = 0; p < nb; p++)
+        {
+            ligne[p] = (ligne[p] - x * precedente[p]) * m;
+        }
+    }
+
+    // Remontée
+    for (int i = n-2; i >= 0; i--)
+    {
+        double c = f.c[i];
+        double* ligne = bloc + i * nb;
+        const double* suivante = ligne + nb;
+        for (int p = 0; p < nb; p++)
+        {
+            ligne[p] -= c * suivante[p];
+        }
+    }
+}
+
+/**
+ * @brief Effectue un pas de theta-schéma en une seule passe de descente : le second membre de la ligne j est calculé par le
+ * stencil explicite sur la tranche de départ juste avant d'être éliminé, sans être écrit en mémoire
+ * @param f Décomposition LU de la partie implicite, dont les lignes 0 et N sont celles de l'identité
+ * @param ex Sous-diagonale de la partie explicite
+ * @param ey Diagonale de la partie explicite
+ * @param ez Sur-diagonale de la partie explicite
+ * @param suivante Tranche de départ
+ * @param courante Tranche calculée, dont les valeurs aux bords sont déjà renseignées et dont on calcule l'intérieur
+ * @param N Nombre de pas d'espace
+ */
+static void pasFusionne(const FactorisationThomas& f, const double* ex, const double* ey, const double* ez, const double* suivante,
+                        double* courante, int N)
+{
+    const double* x = f.x.data();
+    const double* m = f.m.data();
+    const double* c = f.c.data();
+
+    // Descente : le stencil ne dépend que de la tranche de départ, il se calcule en dehors de la chaîne de dépendance en j.
+    // Aux bords la ligne est celle de l'identité et la valeur déjà renseignée est gardée
+    for (int j = 1; j < N; j++)
+    {
+        double b = ex[j] * suivante[j-1] + ey[j] * suivante[j] + ez[j] * suivante[j+1];
+        courante[j] = (b - x[j] * courante[j-1]) * m[j];
+    }
+
+    // Remontée
+    for (int j = N-1; j > 0; j--)
+    {
+        courante[j] -= c[j] * courante[j+1];
+    }
+}
+
 /**
 * @brief Constructeur de la classe DifferencesFinies
 * @param edp Référence vers l'objet EDP à résoudre
-* @param M Nombre de pas de temps
-* @param N Nombre de pas d'espace
-* @param S Valeurs de l'actif S pour lesquelles on calcule la solution
-* @param t Valeurs de temps t pour lesquelles on calcule la solution
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur (par exemple une arène propre à un thread)
+ */
+DifferencesFinies::DifferencesFinies(EDP& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : edp_(edp), maillage_(maillage), M_(maillage->getM()), N_(maillage->getN()), dt_(maillage->getDt()), dS_(maillage->getDS()),
+      t_(maillage->getTemps()), S_(maillage->getActif()), memoire_(memoire) {}
+
+/**
+* @brief Transmet une tranche calculée à l'observateur, s'il y en a un, dans une zone de trace "sortie"
+* @param i Indice de la tranche
+* @param tranche Valeurs C[i] de la tranche
+ */
+void DifferencesFinies::notifier(int i, const std::vector<double>& tranche)
+{
+    if (observateur_)
+    {
+        ZoneTrace sortie("sortie");
+        observateur_(i, tranche);
+    }
+}
+
+/**
+* @brief Constructeur de la classe SchemaTheta
+* @param edp EDP à résoudre, qui fournit l'opérateur L
+* @param maillage Maillage sur lequel on calcule la solution
+* @param theta Poids de la partie implicite, entre 0 et 1, ou THETA_AUTOMATIQUE pour choisir le schéma le moins coûteux
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+SchemaTheta::SchemaTheta(EDP& edp, std::shared_ptr<const Maillage> maillage, double theta, std::pmr::memory_resource* memoire)
+    : DifferencesFinies(edp, maillage, memoire), theta_(theta), f_(N_+1, memoire), ex_(N_+1, memoire), ey_(N_+1, memoire), ez_(N_+1, memoire),
+      rFacto_(std::nan("")), sigmaFacto_(std::nan("")), thetaFacto_(std::nan("")), lissage_(0)
+{
+    // Le schéma explicite ne résout aucun système : c'est le moins coûteux lorsqu'il est stable
+    if (theta_ == THETA_AUTOMATIQUE)
+    {
+        theta_ = estStable(0) ? 0 : 0.5;
+    }
+}
+
+/**
+* @brief Vérifie la condition de stabilité du schéma pour tous les pas de temps du maillage
+* @param theta Poids de la partie implicite à tester
+* @return Vrai si dt (1 - 2 theta) rho(L) <= 2 à chaque pas, rho(L) étant majoré par les disques de Gershgorin
+ */
+bool SchemaTheta::estStable(double theta)
+{
+    // Les schémas avec theta >= 1/2 sont inconditionnellement stables
+    if (theta >= 0.5)
+    {
+        return true;
+    }
+
+    const Option& option = getEdp().getOption();
+    double rPrecedent = std::nan("");
+    double sigmaPrecedent = std::nan("");
+    for (int i = 0; i < M_; i++)
+    {
+        // L'opérateur ne change qu'avec r et sigma
+        double r = option.getR(t_[i]);
+        double sigma = option.getSigma(t_[i]);
+        if (r == rPrecedent && sigma == sigmaPrecedent)
+        {
+            continue;
+        }
+        rPrecedent = r;
+        sigmaPrecedent = sigma;
+
+        // Les valeurs propres de L sont dans les disques de centre b_j et de rayon |a_j| + |c_j|
+        double rho = 0;
+        for (int j = 1; j < N_; j++)
+        {
+            double a, b, c;
+            edp_.operateur(*maillage_, j, r, sigma, a, b, c);
+            rho = std::max(rho, std::abs(a) + std::abs(b) + std::abs(c));
+        }
+        if (dt_ * (1 - 2 * theta) * rho > 2)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+* @brief Calcule les coefficients des deux membres du pas [t_i, t_i+1], s'ils ont changé depuis le pas précédent
+* @param i Indice du pas de temps
+ */
+void SchemaTheta::preparer(int i)
+{
+    // Taux et volatilité sur le pas [t_i, t_i+1]
+    const Option& option = getEdp().getOption();
+    double r = option.getR(t_[i]);
+    double sigma = option.getSigma(t_[i]);
+
+    // Les premiers pas depuis la maturité sont implicites lorsqu'un lissage est demandé
+    double theta = (theta_ > 0 && i >= M_ - lissage_) ? 1 : theta_;
+    if (r == rFacto_ && sigma == sigmaFacto_ && theta == thetaFacto_)
+    {
+        return;
+    }
+
+    for (int j = 0; j <= N_; j++)
+    {
+        // Lignes de l'identité aux bords, le second membre y contenant les conditions aux bords du temps courant
+        double a = 0, b = 0, c = 0;
+        if (j > 0 && j < N_)
+        {
+            edp_.operateur(*maillage_, j, r, sigma, a, b, c);
+        }
+
+        // Partie implicite I - theta dt L, factorisée dans la même passe
+        double x = -theta * dt_ * a;
+        double y = 1 - theta * dt_ * b;
+        double z = -theta * dt_ * c;
+        f_.x[j] = x;
+        f_.m[j] = 1.0 / (j == 0 ? y : y - x * f_.c[j-1]);
+        f_.c[j] = z * f_.m[j];
+
+        // Partie explicite I + (1 - theta) dt L
+        ex_[j] = (1 - theta) * dt_ * a;
+        ey_[j] = 1 + (1 - theta) * dt_ * b;
+        ez_[j] = (1 - theta) * dt_ * c;
+    }
+    rFacto_ = r;
+    sigmaFacto_ = sigma;
+    thetaFacto_ = theta;
+}
+
+/**
+* @brief Applique la partie explicite du schéma sur une plage d'indices d'espace intérieurs
+* @param suivante Tranche i+1
+* @param courante Tranche dans laquelle on écrit (I + (1 - theta) dt L) C_i+1
+* @param debut Premier indice de la plage
+* @param fin Indice suivant le dernier indice de la plage
+ */
+void SchemaTheta::stencil(const double* suivante, double* courante, int debut, int fin) const
+{
+    const double* ex = ex_.data();
+    const double* ey = ey_.data();
+    const double* ez = ez_.data();
+
+    // Les itérations sont indépendantes : la boucle est vectorisée par le compilateur
+    for (int j = debut; j < fin; j++)
+    {
+        courante[j] = ex[j] * suivante[j-1] + ey[j] * suivante[j] + ez[j] * suivante[j+1];
+    }
+}
+
+/**
+* @brief Effectue un pas de temps du schéma, de la tranche i+1 vers la tranche i
+* @param i Indice de la tranche de temps à calculer
+* @param suivante Tranche i+1, déjà calculée
+* @param courante Tranche i, dont les valeurs aux bords sont déjà renseignées et dont on calcule l'intérieur
+ */
+void SchemaTheta::pas(int i, const std::vector<double>& suivante, std::vector<double>& courante)
+{
+    int N = N_;
+    preparer(i);
+
+    // Schéma explicite : aucun système à résoudre. Sinon, partie explicite et descente dans la même passe, les conditions aux
+    // bords du temps courant étant déjà aux extrémités
+    if (theta_ == 0)
+    {
+        stencil(suivante.data(), courante.data(), 1, N);
+    }
+    else
+    {
+        pasFusionne(f_, ex_.data(), ey_.data(), ez_.data(), suivante.data(), courante.data(), N);
+    }
+
+    // Dates de surveillance de l'option (barrière discrète)
+    getEdp().getOption().surveiller(t_[i], dt_, S_, courante);
+}
+
+/**
+* @brief Effectue la marche explicite par blocs de pas de temps et tuiles d'espace, lorsque les coefficients sont constants
+* @param C Matrice initialisée avec les conditions aux bords et terminale
+ */
+void SchemaTheta::marcheExpliciteParBlocs(std::vector<std::vector<double>>& C)
+{
+    // Une tuile de 512 points sur 16 pas de temps (64 Ko de tranches) reste en cache pendant tout le bloc
+    const int LARGEUR_TUILE = 512;
+    const int HAUTEUR_BLOC = 16;
+    int M = M_;
+    int N = N_;
+
+    // Les coefficients sont les mêmes pour tous les pas
+    preparer(M-1);
+
+    for (int i0 = M-1; i0 >= 0; i0 -= HAUTEUR_BLOC)
+    {
+        int hauteur = std::min(HAUTEUR_BLOC, i0 + 1);
+
+        // Tuiles inclinées : au pas k du bloc, la tuile couvre [j0 - k, j0 + LARGEUR_TUILE - k). Ses dépendances à gauche
+        // ont été calculées par la tuile précédente et celles à droite par elle-même au pas k - 1
+        for (int j0 = 1; j0 - (hauteur - 1) < N; j0 += LARGEUR_TUILE)
+        {
+            for (int k = 0; k < hauteur; k++)
+            {
+                int debut = std::max(1, j0 - k);
+                int fin = std::min(N, j0 + LARGEUR_TUILE - k);
+                if (debut < fin)
+                {
+                    stencil(C[i0-k+1].data(), C[i0-k].data(), debut, fin);
+                }
+            }
+        }
+
+        // Les tranches du bloc ne sont complètes qu'une fois toutes les tuiles calculées
+        for (int k = 0; k < hauteur; k++)
+        {
+            notifier(i0 - k, C[i0 - k]);
+        }
+    }
+}
+
+/**
+* @brief Effectue un pas de temps du schéma pour un bloc de seconds membres entrelacés
+* @param i Indice de la tranche de temps à calculer
+* @param nb Nombre de seconds membres
+* @param suivante Tranches i+1 entrelacées, déjà calculées
+* @param courante Tranches i entrelacées, dont les valeurs aux bords sont déjà renseignées et dont on calcule l'intérieur
+ */
+void SchemaTheta::pasBloc(int i, int nb, const double* suivante, double* courante)
+{
+    int N = N_;
+    preparer(i);
+
+    // Partie explicite appliquée aux tranches suivantes, les mêmes coefficients servant à tout le bloc
+    for (int j = 1; j < N; j++)
+    {
+        double ex = ex_[j];
+        double ey = ey_[j];
+        double ez = ez_[j];
+        const double* s = suivante + j * nb;
+        double* ligne = courante + j * nb;
+        if (theta_ == 1)
+        {
+            for (int p = 0; p < nb; p++)
+            {
+                ligne[p] = s[p];
+            }
+        }
+        else
+        {
+            for (int p = 0; p < nb; p++)
+            {
+                ligne[p] = ex * s[p - nb] + ey * s[p] + ez * s[p + nb];
+            }
+        }
+    }
+
+    // Schéma explicite : aucun système à résoudre
+    if (theta_ != 0)
+    {
+        resoudreThomasBloc(f_, nb, courante);
+    }
+}
+
+/**
+* @brief Méthode qui résout l'EDP avec le theta-schéma
+* @return Matrice des valeurs de la solution de l'EDP aux différentes valeurs de S et t
  */
-DifferencesFinies::DifferencesFinies(EDP& edp, int M, int N, std::vector<double>& S, std::vector<double>& t) : edp_(edp), M_(M), N_(N), t_(t), S_(S)
+std::vector<std::vector<double>> SchemaTheta::solve()
 {
-    // Calcul du pas de temps et du pas d'espace
-    dt_ = edp_.getOption().getT() / M_;
-    dS_ = edp_.getOption().getL() / N_;
+    std::vector<std::vector<double>> C;
+    solve(C);
+    return C;
+}
+
+/**
+* @brief Méthode qui résout l'EDP avec le theta-schéma dans une matrice existante
+* @param C Matrice dans laquelle on écrit les valeurs de la solution
+ */
+void SchemaTheta::solve(std::vector<std::vector<double>>& C)
+{
+    ZoneTrace zone("SchemaTheta::solve");
+
+    // On récupère les paramètres de l'EDP
+    const Option& option = getEdp().getOption();
+    int M = getM();
+    int N = getN();
+
+    // Un schéma instable donnerait une solution qui explose : on se rabat sur le schéma implicite pour cette résolution
+    // seulement. Le message va sur la sortie d'erreur, la sortie standard pouvant porter des résultats (serveur de prix)
+    double thetaDemande = theta_;
+    if (!estStable(theta_))
+    {
+        std::cerr << "Erreur : le theta-schéma avec theta = " << theta_ << " est instable sur ce maillage, on utilise theta = 1 pour cette résolution" << std::endl;
+        theta_ = 1;
+    }
+
+    // On initialise la matrice C, de taille (M+1) x (N+1), avec les conditions aux bords et terminale
+    {
+        ZoneTrace initialisation("initialisation");
+        C.resize(M+1);
+        for (auto& ligne : C)
+        {
+            ligne.resize(N+1);
+        }
+        for (int i = 0; i <= M; i++)
+        {
+            for (int j = 0; j <= N; j++)
+            {
+                C[i][j] = option.payoff(S_[j], t_[i]);
+            }
+        }
+    }
+
+    // La tranche terminale est connue dès l'initialisation
+    notifier(M, C[M]);
+
+    ZoneTrace marche("marche");
+
+    // Schéma explicite à coefficients constants et sans dates de surveillance : marche par blocs. Sinon, on calcule les valeurs
+    // de C pas à pas
+    if (theta_ == 0 && option.coefficientsConstants() && !option.estSurveilleeDiscretement())
+    {
+        marcheExpliciteParBlocs(C);
+    }
+    else
+    {
+        for (int i = M-1; i >= 0; i--)
+        {
+            pas(i, C[i+1], C[i]);
+
+            notifier(i, C[i]);
+        }
+    }
+
+    // Le repli éventuel sur le schéma implicite ne vaut que pour cette résolution, les coefficients étant recalculés au
+    // prochain pas puisque theta change
+    theta_ = thetaDemande;
+}
+
+/**
+* @brief Méthode qui résout l'EDP pour plusieurs options partageant l'opérateur du solveur
+* @param options Options à résoudre, de mêmes maturité, domaine, taux et volatilités que l'option de l'EDP
+* @param C C[p] est la matrice des valeurs de la solution de l'option p aux différentes valeurs de S et t
+* @return Faux si une option ne partage pas l'opérateur du solveur (C est alors vide)
+ */
+bool SchemaTheta::solve(const std::vector<const Option*>& options, std::vector<std::vector<std::vector<double>>>& C)
+{
+    ZoneTrace zone("SchemaTheta::solve (bloc)");
+
+    // On récupère les paramètres de l'EDP
+    const Option& option = getEdp().getOption();
+    int nb = options.size();
+    int M = getM();
+    int N = getN();
+    C.clear();
+
+    // Toutes les options doivent conduire à la même matrice à chaque pas de temps
+    for (const Option* autre : options)
+    {
+        bool compatible = autre->getT() == option.getT() && autre->getL() == option.getL()
+                          && autre->getBorneInferieure() == option.getBorneInferieure();
+        for (int i = 0; i < M && compatible; i++)
+        {
+            compatible = autre->getR(t_[i]) == option.getR(t_[i]) && autre->getSigma(t_[i]) == option.getSigma(t_[i]);
+        }
+        if (!compatible)
+        {
+            std::cout << "Erreur : les options résolues en bloc doivent avoir la même maturité, le même domaine, les mêmes taux et les mêmes volatilités" << std::endl;
+            return false;
+        }
+    }
+    if (nb == 0)
+    {
+        return true;
+    }
+
+    // Un schéma instable donnerait une solution qui explose : on se rabat sur le schéma implicite pour cette résolution
+    // seulement. Le message va sur la sortie d'erreur, la sortie standard pouvant porter des résultats (serveur de prix)
+    double thetaDemande = theta_;
+    if (!estStable(theta_))
+    {
+        std::cerr << "Erreur : le theta-schéma avec theta = " << theta_ << " est instable sur ce maillage, on utilise theta = 1 pour cette résolution" << std::endl;
+        theta_ = 1;
+    }
+
+    // On initialise les matrices avec les conditions aux bords et terminale de chaque option, et le bloc avec les tranches
+    // terminales. L'intérieur des autres tranches est écrit par la marche : le payoff n'y est pas évalué
+    std::pmr::vector<double> suivante(nb * (N+1), memoire_);
+    std::pmr::vector<double> courante(nb * (N+1), memoire_);
+    {
+        ZoneTrace initialisation("initialisation");
+        C.resize(nb);
+        for (int p = 0; p < nb; p++)
+        {
+            C[p].assign(M+1, std::vector<double>(N+1));
+            for (int i = 0; i < M; i++)
+            {
+                C[p][i][0] = options[p]->payoff(S_[0], t_[i]);
+                C[p][i][N] = options[p]->payoff(S_[N], t_[i]);
+            }
+            for (int j = 0; j <= N; j++)
+            {
+                C[p][M][j] = options[p]->payoff(S_[j], t_[M]);
+                suivante[j * nb + p] = C[p][M][j];
+            }
+        }
+    }
+
+    // La tranche terminale est connue dès l'initialisation
+    notifier(M, C[0][M]);
+
+    ZoneTrace marche("marche");
+    for (int i = M-1; i >= 0; i--)
+    {
+        for (int p = 0; p < nb; p++)
+        {
+            courante[p] = C[p][i][0];
+            courante[N * nb + p] = C[p][i][N];
+        }
+        pasBloc(i, nb, suivante.data(), courante.data());
+
+        // Les tranches intérieures sont recopiées dans les matrices de chaque option. Une option dont la tranche est modifiée
+        // par une date de surveillance la réécrit dans le bloc
+        for (int p = 0; p < nb; p++)
+        {
+            std::vector<double>& ligne = C[p][i];
+            for (int j = 1; j < N; j++)
+            {
+                ligne[j] = courante[j * nb + p];
+            }
+            if (options[p]->surveiller(t_[i], dt_, S_, ligne))
+            {
+                for (int j = 0; j <= N; j++)
+                {
+                    courante[j * nb + p] = ligne[j];
+                }
+            }
+        }
+        std::swap(suivante, courante);
+
+        notifier(i, C[0][i]);
+    }
+
+    // Le repli éventuel sur le schéma implicite ne vaut que pour cette résolution
+    theta_ = thetaDemande;
+    return true;
 }
 
 /**
@@ -64,112 +603,583 @@ DifferencesFinies::DifferencesFinies(EDP& edp, int M, int N, std::vector<double>
 * @param edp EDP complète à résoudre
 * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
 * @param t Valeurs du temps t pour lesquelles on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
  */
-CrankNicholson::CrankNicholson(EDPComplete& edp, std::vector<double>& S, std::vector<double>& t) : DifferencesFinies(edp, t.size()-1, S.size()-1, S, t) {}
+CrankNicholson::CrankNicholson(EDPComplete& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire)
+    : CrankNicholson(edp, std::make_shared<const Maillage>(t, S), memoire) {}
 
 /**
-* @brief Méthode qui résout l'EDP complète en utilisant la méthode de Crank Nicholson
-* @return Matrice des valeurs de la solution de l'EDP complète aux différentes valeurs de S et t
+* @brief Constructeur de la classe CrankNicholson sur un maillage partagé
+* @param edp EDP complète à résoudre
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
  */
-std::vector<std::vector<double>> CrankNicholson::solve()
+CrankNicholson::CrankNicholson(EDPComplete& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : SchemaTheta(edp, maillage, 0.5, memoire)
 {
-    // On récupère les paramètres de l'EDP
-    double r = getEdp().getOption().getR();
-    double sigma = getEdp().getOption().getSigma();
-    double M = getM();
-    double N = getN();
+    lissage_ = PAS_LISSAGE;
+}
+
+/**
+* @brief Constructeur de la classe CrankNicholsonParesseux : seule la tranche terminale est calculée
+* @param edp EDP complète à résoudre
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+CrankNicholsonParesseux::CrankNicholsonParesseux(EDPComplete& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : CrankNicholson(edp, maillage, memoire), tranches_(M_+1), iCalcule_(M_)
+{
+    const Option& option = getEdp().getOption();
+    tranches_[M_].resize(N_+1);
+    for (int j = 0; j <= N_; j++)
+    {
+        tranches_[M_][j] = option.payoff(S_[j], t_[M_]);
+    }
+}
 
-    // On initialise les vecteurs de la matrice tridiagonale
-    std::vector<double> x(N+1);
-    std::vector<double> y(N+1);
-    std::vector<double> z(N+1);
+/**
+* @brief Méthode qui retourne la tranche i, en poursuivant la marche rétrograde si elle n'a pas encore été atteinte
+* @param i Indice de la tranche de temps
+* @return Référence vers les valeurs de la solution aux différentes valeurs de S, valide tant que l'instance existe
+ */
+const std::vector<double>& CrankNicholsonParesseux::tranche(int i)
+{
+    const Option& option = getEdp().getOption();
 
-    // On calcule les coefficients x, y et z
-    for (int j = 0; j <= N; j++)
+    // On reprend la marche depuis la dernière tranche calculée, sans jamais recalculer les tranches déjà atteintes
+    ZoneTrace marche(iCalcule_ > i ? "marche" : "lecture");
+    while (iCalcule_ > i)
     {
-        x[j] = dt_ * ((j+1) / (2 * dS_) * (r - sigma * sigma / dS_));
-        y[j] = dt_ * (1.0 / dt_ + sigma * sigma * (j+1) * (j+1) / (dS_ * dS_) + r);
-        z[j] = dt_ * (-(j+1) / (2 * dS_) * (r + sigma * sigma / dS_));
+        int k = iCalcule_ - 1;
+        tranches_[k].resize(N_+1);
+        tranches_[k][0] = option.payoff(S_[0], t_[k]);
+        tranches_[k][N_] = option.payoff(S_[N_], t_[k]);
+        pas(k, tranches_[k+1], tranches_[k]);
+        iCalcule_ = k;
+
+        notifier(k, tranches_[k]);
     }
 
-    // On initialise la matrice C avec les conditions aux bords et terminale
-    std::vector<std::vector<double>> C(N+1, std::vector<double>(M+1));
-    for (int i = 0; i <= M; i++)
+    return tranches_[i];
+}
+
+/**
+* @brief Méthode qui retourne la tranche du maillage la plus proche d'un temps donné
+* @param t Temps auquel on veut la solution (compris entre 0 et T)
+* @return Référence vers les valeurs de la solution aux différentes valeurs de S
+ */
+const std::vector<double>& CrankNicholsonParesseux::solve(double t)
+{
+    int i = std::lround((t - t_[0]) / dt_);
+    return tranche(std::min(std::max(i, 0), M_));
+}
+
+/**
+* @brief Méthode qui retourne le prix en un point, par interpolation linéaire en S sur la tranche la plus proche de t
+* @param S Valeur de l'actif (comprise entre 0 et L)
+* @param t Temps (compris entre 0 et T)
+* @return Prix de l'option
+ */
+double CrankNicholsonParesseux::prix(double S, double t)
+{
+    const std::vector<double>& C = solve(t);
+
+    // Indice de la maille contenant S et position dans la maille
+    double u = (S - S_[0]) * maillage_->getInvDS();
+    int j = std::min(std::max(static_cast<int>(u), 0), N_ - 1);
+    double a = u - j;
+
+    return (1 - a) * C[j] + a * C[j+1];
+}
+
+/**
+* @brief Constructeur de la classe Implicite
+* @param edp EDP réduite à résoudre
+* @param S Valeurs de l'actif S pour lesquelles on calcule la solution
+* @param t Valeurs du temps t pour lesquelles on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+Implicite::Implicite(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire)
+    : Implicite(edp, std::make_shared<const Maillage>(t, S), memoire) {}
+
+/**
+* @brief Constructeur de la classe Implicite sur un maillage partagé
+* @param edp EDP réduite à résoudre
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+Implicite::Implicite(EDPReduite& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : SchemaTheta(edp, maillage, 1, memoire) {}
+
+/**
+* @brief Constructeur de la classe SchemaAdaptatif
+* @param edp EDP à résoudre, qui fournit l'opérateur L
+* @param maillage Maillage dont on utilise l'axe de l'actif, la maturité et le pas de temps, qui sert de pas initial
+* @param tolerance Erreur en temps visée sur la solution à t = 0
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+SchemaAdaptatif::SchemaAdaptatif(EDP& edp, std::shared_ptr<const Maillage> maillage, double tolerance, std::pmr::memory_resource* memoire)
+    : DifferencesFinies(edp, maillage, memoire), tolerance_(tolerance), cache_(memoire), rCache_(std::nan("")), sigmaCache_(std::nan("")),
+      poids_(N_+1, 0, memoire), nbFactorisations_(0), nbRejets_(0) {}
+
+/**
+* @brief Retourne les membres du schéma pour un niveau, en les calculant s'ils ne sont pas en cache
+* @param k Niveau du pas dt 2^k
+* @param r Taux d'intérêt sur le pas
+* @param sigma Volatilité sur le pas
+* @return Référence vers les membres du schéma
+ */
+const SchemaAdaptatif::Niveau& SchemaAdaptatif::niveau(int k, double r, double sigma)
+{
+    // Les niveaux en cache ne sont valables que pour le taux et la volatilité avec lesquels ils ont été calculés
+    if (r != rCache_ || sigma != sigmaCache_)
     {
-        for (int j = 0; j <= N; j++)
+        cache_.clear();
+        rCache_ = r;
+        sigmaCache_ = sigma;
+
+        // Coefficient de diffusion D_j = (a_j + c_j) dS^2 / 2 de chaque ligne de l'opérateur (sigma^2 S^2 / 2 pour l'EDP complète)
+        const double pi = std::acos(-1.0);
+        for (int j = 1; j < N_; j++)
         {
-            C[i][j] = getEdp().getOption().payoff(S_[j], t_[i]);
+            double a, b, c;
+            edp_.operateur(*maillage_, j, r, sigma, a, b, c);
+            double diffusion = 0.5 * (a + c) * dS_ * dS_;
+            poids_[j] = diffusion > 0 ? dS_ / std::sqrt(4 * pi * diffusion) : 0;
         }
     }
+    auto trouve = cache_.find(k);
+    if (trouve != cache_.end())
+    {
+        return trouve->second;
+    }
 
-    // On calcule les valeurs de C en utilisant la méthode de Crank Nicholson
-    for (int i = M-1; i >= 0; i--)
+    Niveau& n = cache_.emplace(k, Niveau(N_+1, memoire_)).first->second;
+    double demiPas = 0.5 * std::ldexp(dt_, k);
+    for (int j = 0; j <= N_; j++)
+    {
+        // Lignes de l'identité aux bords
+        double a = 0, b = 0, c = 0;
+        if (j > 0 && j < N_)
+        {
+            edp_.operateur(*maillage_, j, r, sigma, a, b, c);
+        }
+        double x = -demiPas * a;
+        double y = 1 - demiPas * b;
+        n.f.x[j] = x;
+        n.f.m[j] = 1.0 / (j == 0 ? y : y - x * n.f.c[j-1]);
+        n.f.c[j] = -demiPas * c * n.f.m[j];
+        n.ex[j] = demiPas * a;
+        n.ey[j] = 1 + demiPas * b;
+        n.ez[j] = demiPas * c;
+    }
+    nbFactorisations_++;
+    return n;
+}
+
+/**
+* @brief Effectue un pas de Crank Nicholson
+* @param n Membres du schéma du pas
+* @param suivante Tranche de départ, au temps t + h
+* @param courante Tranche calculée, au temps t
+* @param t Temps d'arrivée, pour les conditions aux bords
+ */
+void SchemaAdaptatif::pas(const Niveau& n, const double* suivante, double* courante, double t)
+{
+    const Option& option = getEdp().getOption();
+    int N = N_;
+
+    courante[0] = option.payoff(S_[0], t);
+    courante[N] = option.payoff(S_[N], t);
+    pasFusionne(n.f, n.ex.data(), n.ey.data(), n.ez.data(), suivante, courante, N);
+}
+
+/**
+* @brief Méthode qui résout l'EDP avec le pas de temps adaptatif
+* @return Matrice des valeurs de la solution de l'EDP, de t = 0 à t = T
+ */
+std::vector<std::vector<double>> SchemaAdaptatif::solve()
+{
+    ZoneTrace zone("SchemaAdaptatif::solve");
+
+    // Le temps restant est compté en unités entières de dt / 2^PROFONDEUR, de sorte que la marche finit exactement en t = 0
+    const int PROFONDEUR = 10;
+    const Option& option = getEdp().getOption();
+    int N = getN();
+    double T = t_.back();
+    double unite = std::ldexp(dt_, -PROFONDEUR);
+    long long reste = static_cast<long long>(M_) << PROFONDEUR;
+    nbFactorisations_ = 0;
+    nbRejets_ = 0;
+
+    // Les tranches sont calculées de la maturité vers t = 0, puis remises dans l'ordre des temps croissants
+    std::vector<std::vector<double>> C(1, std::vector<double>(N+1));
+    temps_.assign(1, T);
+    for (int j = 0; j <= N; j++)
     {
-        std::vector<double> solution = algoThomas(x, y, z, C[i+1]);
+        C[0][j] = option.payoff(S_[j], T);
+    }
+
+    std::pmr::vector<double> entier(N+1, memoire_);
+    std::pmr::vector<double> milieu(N+1, memoire_);
+    std::pmr::vector<double> fin(N+1, memoire_);
+    int k = 0;
+    ZoneTrace marche("marche");
+    while (reste > 0)
+    {
+        // On ne dépasse pas t = 0
+        while ((1LL << (k + PROFONDEUR)) > reste)
+        {
+            k--;
+        }
+        long long arrivee = reste - (1LL << (k + PROFONDEUR));
+        double h = std::ldexp(dt_, k);
+        double t = arrivee * unite;
+        double tMilieu = (arrivee + (1LL << (k + PROFONDEUR - 1))) * unite;
+
+        // Un pas entier et deux demi-pas, au taux et à la volatilité du début du pas
+        double r = option.getR(t);
+        double sigma = option.getSigma(t);
+        const double* suivante = C.back().data();
+        pas(niveau(k, r, sigma), suivante, entier.data(), t);
+        const Niveau& demi = niveau(k - 1, r, sigma);
+        pas(demi, suivante, milieu.data(), tMilieu);
+        pas(demi, milieu.data(), fin.data(), t);
+
+        // L'erreur locale du schéma d'ordre 2 est l'écart entre les deux solutions divisé par 2^3 - 1. Jusqu'en t = 0, elle
+        // est diffusée par le noyau de l'EDP, de largeur sqrt(4 pi D_j t) : son effet sur un prix est au plus sa norme L1
+        // pondérée par l'inverse de cette largeur, et au plus sa norme infinie
+        double erreurMax = 0;
+        double erreurDiffusee = 0;
         for (int j = 1; j < N; j++)
         {
-            C[i][j] = solution[j];
+            double e = std::abs(fin[j] - entier[j]);
+            erreurMax = std::max(erreurMax, e);
+            erreurDiffusee += e * poids_[j];
+        }
+        double erreur = (t > 0 ? std::min(erreurMax, erreurDiffusee / std::sqrt(t)) : erreurMax) / 7;
+
+        // Pas rejeté : on recommence avec un pas deux fois plus petit, sauf au pas minimal
+        double admissible = tolerance_ * h / T;
+        if (erreur > admissible && k > 1 - PROFONDEUR)
+        {
+            k--;
+            nbRejets_++;
+            continue;
+        }
+
+        C.emplace_back(fin.begin(), fin.end());
+        temps_.push_back(t);
+        reste = arrivee;
+
+        // Une date de surveillance comprise dans le pas est appliquée à son début
+        option.surveiller(t, h, S_, C.back());
+
+        // Doubler le pas multiplie l'erreur locale par 8 et l'erreur admise par 2 : on double si la marge est suffisante
+        if (4 * erreur < 0.5 * admissible)
+        {
+            k++;
         }
     }
 
+    ZoneTrace sortie("sortie");
+    std::reverse(C.begin(), C.end());
+    std::reverse(temps_.begin(), temps_.end());
     return C;
 }
 
 /**
-* @brief Constructeur de la classe Implicite
+* @brief Constructeur de la classe NoyauChaleur
 * @param edp EDP réduite à résoudre
 * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
 * @param t Valeurs du temps t pour lesquelles on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
  */
-Implicite::Implicite(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t) : DifferencesFinies(edp, t.size()-1, S.size()-1, S, t) {}
+NoyauChaleur::NoyauChaleur(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire)
+    : NoyauChaleur(edp, std::make_shared<const Maillage>(t, S), memoire) {}
 
 /**
-* @brief Méthode qui résout l'EDP réduite en utilisant la méthode Implicite
-* @return Matrice des valeurs de la solution de l'EDP réduite aux différentes valeurs de S et t
+* @brief Constructeur de la classe NoyauChaleur sur un maillage partagé
+* @param edp EDP réduite à résoudre
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
  */
-std::vector<std::vector<double>> Implicite::solve()
+NoyauChaleur::NoyauChaleur(EDPReduite& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : DifferencesFinies(edp, maillage, memoire), edpReduite_(edp), terminalFFT_(memoire)
 {
+    // Si les coefficients ne sont pas constants, la méthode Implicite de repli sera utilisée
+    if (!getEdp().getOption().coefficientsConstants())
+    {
+        marge_ = 0;
+        return;
+    }
+
     // On récupère les paramètres de l'EDP
+    double T = getEdp().getOption().getT();
     double sigma = getEdp().getOption().getSigma();
-    double M = getM();
-    double N = getN();
+    int N = getN();
+
+    // La marge couvre 8 écarts-types du noyau le plus large (celui de t = 0)
+    marge_ = std::max(1, static_cast<int>(std::ceil(8 * sigma * std::sqrt(T) / dS_)));
 
-    // On calcule le coefficient lambda
-    double lambda = (sigma * sigma * dt_) / (2 * dS_ * dS_);
+    // On prolonge la condition terminale par ses valeurs aux bords sur une grille de taille puissance de 2
+    int n = puissanceDeDeux(N + 1 + 2 * marge_);
+    terminalFFT_.resize(n);
+    for (int k = 0; k < n; k++)
+    {
+        int j = std::min(std::max(k - marge_, 0), N);
+        terminalFFT_[k] = getEdp().getOption().payoff(S_[j], T);
+    }
 
-    // On initialise les vecteurs de la matrice tridiagonale
-    std::vector<double> x(N+1);
-    std::vector<double> y(N+1);
-    std::vector<double> z(N+1);
+    // La transformée de la condition terminale est calculée une seule fois pour toutes les tranches
+    fft(terminalFFT_.data(), n, false);
+}
 
-    // On calcule les coefficients x, y et z
+/**
+* @brief Calcule une seule fois la solution de la méthode Implicite de repli, utilisée lorsque les coefficients ne sont pas constants
+* @param avecObservateur Vrai pour transmettre à l'observateur les tranches au fur et à mesure de la marche
+* @return Référence vers la solution de repli
+ */
+const std::vector<std::vector<double>>& NoyauChaleur::repli(bool avecObservateur)
+{
+    // Une seule marche pour toutes les tranches demandées : les suivantes sont lues dans la solution gardée
+    if (repli_.empty())
+    {
+        Implicite implicite(edpReduite_, maillage_, memoire_);
+        if (avecObservateur)
+        {
+            implicite.setObservateur(observateur_);
+        }
+        implicite.solve(repli_);
+    }
+    else if (avecObservateur)
+    {
+        for (int i = getM(); i >= 0; i--)
+        {
+            notifier(i, repli_[i]);
+        }
+    }
+
+    return repli_;
+}
+
+/**
+* @brief Méthode qui calcule directement la solution de l'EDP réduite à un temps donné
+* @param t Temps auquel on calcule la solution (compris entre 0 et T)
+* @return Vecteur des valeurs de la solution de l'EDP réduite aux différentes valeurs de S au temps t
+ */
+std::vector<double> NoyauChaleur::solve(double t)
+{
+    // On récupère les paramètres de l'EDP
+    double T = getEdp().getOption().getT();
+    double sigma = getEdp().getOption().getSigma();
+    int M = getM();
+    int N = getN();
+
+    // Repli sur la méthode Implicite lorsque les coefficients ne sont pas constants
+    if (!getEdp().getOption().coefficientsConstants())
+    {
+        const std::vector<std::vector<double>>& C = repli(false);
+        int i = 0;
+        for (int k = 1; k <= M; k++)
+        {
+            if (std::abs(t_[k] - t) < std::abs(t_[i] - t))
+            {
+                i = k;
+            }
+        }
+        return C[i];
+    }
+
+    std::vector<double> C(N+1);
+
+    // Au temps terminal la solution est donnée par le payoff
+    if (t >= T)
+    {
+        for (int j = 0; j <= N; j++)
+        {
+            C[j] = getEdp().getOption().payoff(S_[j], T);
+        }
+        return C;
+    }
+
+    // L'EDP réduite est une équation de la chaleur de coefficient sigma^2 / 2 : le noyau est une gaussienne d'écart-type s
+    double s = sigma * std::sqrt(T - t);
+
+    // On multiplie la transformée de la condition terminale par celle du noyau gaussien
+    const double pi = std::acos(-1.0);
+    int n = terminalFFT_.size();
+    std::pmr::vector<std::complex<double>> a(n, memoire_);
+    for (int k = 0; k < n; k++)
+    {
+        double omega = 2 * pi * (k <= n / 2 ? k : k - n) / (n * dS_);
+        a[k] = terminalFFT_[k] * std::exp(-0.5 * s * s * omega * omega);
+    }
+
+    // On revient dans l'espace de l'actif S
+    fft(a.data(), n, true);
     for (int j = 0; j <= N; j++)
     {
-        x[j] = lambda;
-        y[j] = 1 - 2 * lambda;
-        z[j] = lambda;
+        C[j] = a[j + marge_].real();
+    }
+
+    // On impose les conditions aux bords
+    C[0] = getEdp().getOption().payoff(S_[0], t);
+    C[N] = getEdp().getOption().payoff(S_[N], t);
+
+    return C;
+}
+
+/**
+* @brief Méthode qui résout l'EDP réduite pour toutes les valeurs de t
+* @return Matrice des valeurs de la solution de l'EDP réduite aux différentes valeurs de S et t
+ */
+std::vector<std::vector<double>> NoyauChaleur::solve()
+{
+    ZoneTrace zone("NoyauChaleur::solve");
+
+    // Repli sur la méthode Implicite lorsque les coefficients ne sont pas constants
+    if (!getEdp().getOption().coefficientsConstants())
+    {
+        return repli(true);
+    }
+
+    // Chaque tranche est calculée indépendamment des autres
+    int M = getM();
+    std::vector<std::vector<double>> C(M+1);
+    for (int i = M; i >= 0; i--)
+    {
+        C[i] = solve(t_[i]);
+
+        notifier(i, C[i]);
     }
 
-    // On initialise la matrice C avec les conditions aux bords et terminale
-    std::vector<std::vector<double>> C(N+1, std::vector<double>(M+1));
+    return C;
+}
+
+/**
+* @brief Constructeur de la classe CrankNicholsonVolLocale
+* @param edp EDP complète avec volatilité locale à résoudre
+* @param S Valeurs de l'actif S pour lesquelles on calcule la solution
+* @param t Valeurs du temps t pour lesquelles on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+CrankNicholsonVolLocale::CrankNicholsonVolLocale(EDPVolLocale& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire)
+    : CrankNicholsonVolLocale(edp, std::make_shared<const Maillage>(t, S), memoire) {}
+
+/**
+* @brief Constructeur de la classe CrankNicholsonVolLocale sur un maillage partagé
+* @param edp EDP complète avec volatilité locale à résoudre
+* @param maillage Maillage sur lequel on calcule la solution
+* @param memoire Ressource mémoire des vecteurs de travail du solveur
+ */
+CrankNicholsonVolLocale::CrankNicholsonVolLocale(EDPVolLocale& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire)
+    : DifferencesFinies(edp, maillage, memoire), sigma2_(memoire)
+{
+    int M = getM();
+    int N = getN();
+
+    // On échantillonne la surface une seule fois : la tranche i est contiguë en mémoire
+    sigma2_.resize((M+1) * (N+1));
     for (int i = 0; i <= M; i++)
     {
         for (int j = 0; j <= N; j++)
         {
-            C[i][j] = getEdp().getOption().payoff(S_[j], t_[i]);
+            double sigma = edp.getVolLocale(S_[j], t_[i]);
+            sigma2_[i * (N+1) + j] = sigma * sigma;
         }
     }
+}
+
+/**
+* @brief Méthode qui résout l'EDP complète avec volatilité locale en utilisant la méthode de Crank Nicholson
+* @return Matrice des valeurs de la solution de l'EDP aux différentes valeurs de S et t
+ */
+std::vector<std::vector<double>> CrankNicholsonVolLocale::solve()
+{
+    std::vector<std::vector<double>> C;
+    solve(C);
+    return C;
+}
 
-    // On calcule les valeurs de C en utilisant la méthode Implicite
+/**
+* @brief Méthode qui résout l'EDP complète avec volatilité locale en utilisant la méthode de Crank Nicholson dans une matrice existante
+* @param C Matrice dans laquelle on écrit les valeurs de la solution
+ */
+void CrankNicholsonVolLocale::solve(std::vector<std::vector<double>>& C)
+{
+    ZoneTrace zone("CrankNicholsonVolLocale::solve");
+
+    // On récupère les paramètres de l'EDP
+    const Option& option = getEdp().getOption();
+    int M = getM();
+    int N = getN();
+
+    // On initialise la matrice C, de taille (M+1) x (N+1), avec les conditions aux bords et terminale
+    {
+        ZoneTrace initialisation("initialisation");
+        C.resize(M+1);
+        for (auto& ligne : C)
+        {
+            ligne.resize(N+1);
+        }
+        for (int i = 0; i <= M; i++)
+        {
+            for (int j = 0; j <= N; j++)
+            {
+                C[i][j] = option.payoff(S_[j], t_[i]);
+            }
+        }
+    }
+
+    // La tranche terminale est connue dès l'initialisation
+    notifier(M, C[M]);
+
+    ZoneTrace marche("marche");
+
+    // Vecteurs temporaires de l'algorithme de Thomas
+    std::pmr::vector<double> c(N+1, memoire_);
+    std::pmr::vector<double> d(N+1, memoire_);
+
+    // On calcule les valeurs de C en utilisant la méthode de Crank Nicholson
     for (int i = M-1; i >= 0; i--)
     {
-        // On résout le système linéaire P1 * C[i] = C[i+1]
-        std::vector<double> solution = algoThomas(x, y, z, C[i+1]);
+        double r = option.getR(t_[i]);
+        const double* sigma2 = &sigma2_[i * (N+1)];
+        const std::vector<double>& b = C[i+1];
+
+        // Poids de la partie explicite : (1 - theta) / theta vaut 1 pour Crank Nicholson et 0 pour les pas implicites du démarrage
+        double theta = i >= M - CrankNicholson::PAS_LISSAGE ? 1 : 0.5;
+        double k = (1 - theta) / theta;
+
+        // Assemblage des coefficients, stencil explicite et descente de Thomas dans la même boucle
+        for (int j = 0; j <= N; j++)
+        {
+            double x, y, z;
+            coefficientsCrankNicholson(*maillage_, j, r, sigma2[j], theta, x, y, z);
+
+            // Aux bords, le second membre contient les conditions aux bords du temps courant
+            double bj = (j == 0 || j == N) ? C[i][j] : b[j] + k * (b[j] - (x * b[j-1] + y * b[j] + z * b[j+1]));
+
+            double m = 1.0 / (j == 0 ? y : y - x * c[j-1]);
+            c[j] = z * m;
+            d[j] = (j == 0 ? bj : bj - x * d[j-1]) * m;
+        }
+
+        // Remontée
+        for (int j = N-1; j >= 0; j--)
+        {
+            d[j] -= c[j] * d[j+1];
+        }
+
         for (int j = 1; j < N; j++)
         {
-            C[i][j] = solution[j];
-        } 
-    }
+            C[i][j] = d[j];
+        }
 
-    return C;
+        // Dates de surveillance de l'option (barrière discrète)
+        option.surveiller(t_[i], dt_, S_, C[i]);
+
+        notifier(i, C[i]);
+    }
 }
@@ -1,15 +1,21 @@
 /**
  * @file diff_finies.h
- * @brief Déclarations de la classe abstraite DifferencesFinies et de ses classes concrètes CrankNicholson et Implicite
+ * @brief Déclarations de la classe abstraite DifferencesFinies et de ses classes concrètes SchemaTheta, CrankNicholson, Implicite, SchemaAdaptatif, NoyauChaleur et CrankNicholsonVolLocale
  */
 
 #ifndef DIFF_FINIES_H
 #define DIFF_FINIES_H
 
 #include "edp.h" // Pour la déclaration de la classe EDP
+#include "maillage.h" // Pour la déclaration de la classe Maillage
 
 #include <vector> // Pour std::vector
-#include <iostream> // Pour std::cout et std::endl
+#include <complex> // Pour std::complex
+#include <functional> // Pour std::function
+#include <memory> // Pour std::shared_ptr
+#include <memory_resource> // Pour std::pmr::memory_resource et std::pmr::vector
+#include <map> // Pour std::pmr::map
+#include <iostream> // Pour std::cout, std::cerr et std::endl
 
 /**
  * @brief Méthode qui résout un système linéaire de la forme A * sol = b en utilisant une décomposition LU
@@ -17,9 +23,82 @@
  * @param x Vecteur représentant la diagonale de la matrice
  * @param x Vecteur représentant la sous-diagonale de la matrice
  * @param b Vecteur du système linéaire
+ * @param memoire Ressource mémoire dans laquelle sont alloués les vecteurs temporaires de l'algorithme
  * @return Vecteur solution sol du système linéaire
  */
-std::vector<double> algoThomas(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::vector<double>& b);
+std::vector<double> algoThomas(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::vector<double>& b,
+                               std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+/**
+ * @brief Structure contenant la décomposition LU d'une matrice tridiagonale, réutilisable pour plusieurs seconds membres
+ */
+struct FactorisationThomas
+{
+    std::pmr::vector<double> x; // Sous-diagonale de la matrice
+    std::pmr::vector<double> c; // Sur-diagonale modifiée par l'élimination
+    std::pmr::vector<double> m; // Inverses des pivots de l'élimination
+
+    /**
+     * @brief Constructeur de la structure FactorisationThomas
+     * @param n Taille de la matrice
+     * @param memoire Ressource mémoire dans laquelle sont alloués les vecteurs de la décomposition
+     */
+    FactorisationThomas(int n, std::pmr::memory_resource* memoire) : x(n, memoire), c(n, memoire), m(n, memoire) {}
+};
+
+/**
+ * @brief Méthode qui résout un système linéaire A * sol = b à partir de la décomposition LU de A
+ * @param f Décomposition LU de la matrice A
+ * @param b Vecteur du système linéaire
+ * @param sol Vecteur dans lequel on écrit la solution du système linéaire
+ */
+void resoudreThomas(const FactorisationThomas& f, const std::pmr::vector<double>& b, std::pmr::vector<double>& sol);
+
+/**
+ * @brief Méthode qui résout en place les systèmes A * sol_p = b_p d'un bloc de seconds membres entrelacés
+ *
+ * Le coefficient j du second membre p est rangé en bloc[j * nb + p] : à chaque ligne, les nb substitutions sont indépendantes
+ * et contiguës, et la boucle sur p est vectorisée par le compilateur
+ *
+ * @param f Décomposition LU de la matrice A
+ * @param nb Nombre de seconds membres
+ * @param bloc Seconds membres entrelacés, remplacés par les solutions
+ */
+void resoudreThomasBloc(const FactorisationThomas& f, int nb, double* bloc);
+
+/**
+ * @brief Calcule les coefficients de la ligne j de la partie implicite I - theta dt L du theta-schéma sur l'EDP complète
+ *
+ * Avec S_j = j * dS, les termes S^2 / dS^2 et S / dS valent j^2 et j et sont lus dans le maillage. Les lignes des bords
+ * (j = 0 et j = N) sont celles de l'identité, le second membre y contenant les conditions aux bords du temps courant.
+ * La partie explicite s'en déduit : I + (1 - theta) dt L = I + (1 - theta) / theta (I - (I - theta dt L))
+ *
+ * @param maillage Maillage de la résolution
+ * @param j Indice d'espace
+ * @param r Taux d'intérêt sur le pas de temps
+ * @param sigma2 Carré de la volatilité au noeud j sur le pas de temps
+ * @param theta Poids de la partie implicite (1/2 pour Crank Nicholson)
+ * @param x Sous-diagonale de la ligne j
+ * @param y Diagonale de la ligne j
+ * @param z Sur-diagonale de la ligne j
+ */
+inline void coefficientsCrankNicholson(const Maillage& maillage, int j, double r, double sigma2, double theta, double& x, double& y, double& z)
+{
+    if (j == 0 || j == maillage.getN())
+    {
+        x = 0;
+        y = 1;
+        z = 0;
+        return;
+    }
+
+    double dt = theta * maillage.getDt();
+    double j1 = maillage.getIndices()[j];
+    double j2 = maillage.getIndicesCarres()[j];
+    x = -0.5 * dt * (sigma2 * j2 - r * j1);
+    y = 1 + dt * (sigma2 * j2 + r);
+    z = -0.5 * dt * (sigma2 * j2 + r * j1);
+}
 
 /**
  * @brief Classe abstraite représentant une méthode de différences finies pour résoudre une équation différentielle
@@ -28,23 +107,31 @@ class DifferencesFinies
 {
     protected:
         EDP& edp_;  // Référence vers l'objet EDP à résoudre
+        std::shared_ptr<const Maillage> maillage_; // Maillage partagé, en lecture seule
         int M_;     // Nombre de pas de temps
         int N_;     // Nombre de pas d'espace
         double dt_; // Pas de temps
         double dS_; // Pas d'espace
-        std::vector<double>& t_; // Valeurs de temps t pour lesquelles on calcule la solution
-        std::vector<double>& S_; // Valeurs de l'actif S pour lesquelles on calcule la solution
+        const std::vector<double>& t_; // Valeurs de temps t pour lesquelles on calcule la solution (axe du maillage)
+        const std::vector<double>& S_; // Valeurs de l'actif S pour lesquelles on calcule la solution (axe du maillage)
+        std::function<void(int, const std::vector<double>&)> observateur_; // Fonction appelée à chaque tranche de temps calculée
+        std::pmr::memory_resource* memoire_; // Ressource mémoire des vecteurs de travail du solveur
+
+        /**
+         * @brief Transmet une tranche calculée à l'observateur, s'il y en a un, dans une zone de trace "sortie"
+         * @param i Indice de la tranche
+         * @param tranche Valeurs C[i] de la tranche
+         */
+        void notifier(int i, const std::vector<double>& tranche);
 
     public:
         /**
          * @brief Constructeur de la classe DifferencesFinies
          * @param edp Référence vers l'objet EDP à résoudre
-         * @param M Nombre de pas de temps
-         * @param N Nombre de pas d'espace
-         * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
-         * @param t Valeurs de temps t pour lesquelles on calcule la solution
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur (par exemple une arène propre à un thread)
          */
-        DifferencesFinies(EDP& edp, int M, int N, std::vector<double>& S, std::vector<double>& t);
+        DifferencesFinies(EDP& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire);
 
         /**
         * @brief Getter pour l'objet EDP associé à cette instance de DifferencesFinies
@@ -52,44 +139,238 @@ class DifferencesFinies
         */
         EDP& getEdp() { return edp_; }
 
+        /**
+        * @brief Getter pour le maillage associé à cette instance de DifferencesFinies
+        * @return Maillage partagé, à transmettre à d'autres solveurs de même grille
+        */
+        std::shared_ptr<const Maillage> getMaillage() { return maillage_; }
+
         /**
         * @brief Getter pour le nombre de pas de temps associé à cette instance de DifferencesFinies
         * @return Nombre de pas de temps associé à cette instance de DifferencesFinies
         */
-        double getM() { return M_; }
+        int getM() { return M_; }
 
         /**
         * @brief Getter pour le nombre de pas d'espace associé à cette instance de DifferencesFinies
         * @return Nombre de pas d'espace associé à cette instance de DifferencesFinies
         */
-        double getN() { return N_; }
+        int getN() { return N_; }
+
+        /**
+        * @brief Définit une fonction appelée par solve() dès qu'une tranche de temps est calculée
+        * @param observateur Fonction recevant l'indice i de la tranche et les valeurs C[i] correspondantes
+        */
+        void setObservateur(std::function<void(int, const std::vector<double>&)> observateur) { observateur_ = observateur; }
+
+        /**
+        * @brief Getter pour la ressource mémoire des vecteurs de travail du solveur
+        * @return Pointeur vers la ressource mémoire
+        */
+        std::pmr::memory_resource* getMemoire() { return memoire_; }
+};
+
+/**
+ * @brief Classe qui implémente le theta-schéma (I - theta dt L) C_i = (I + (1 - theta) dt L) C_i+1 pour l'opérateur L de l'EDP
+ *
+ * theta = 0 donne le schéma explicite, theta = 1/2 le schéma de Crank Nicholson et theta = 1 le schéma implicite. Le schéma
+ * explicite ne résout aucun système : chaque pas est un stencil à trois points, appliqué par tuiles d'espace sur plusieurs pas
+ * de temps successifs tant que les coefficients sont constants, de sorte que les tranches intermédiaires restent en cache.
+ * Un schéma avec theta < 1/2 n'est stable que si dt (1 - 2 theta) rho(L) <= 2 : cette condition est vérifiée avant la résolution
+ */
+class SchemaTheta : public DifferencesFinies
+{
+    protected:
+        double theta_; // Poids de la partie implicite du schéma
+        FactorisationThomas f_; // Décomposition LU de I - theta dt L, reconstruite uniquement lorsque r ou sigma changent
+        std::pmr::vector<double> ex_; // Sous-diagonale de I + (1 - theta) dt L
+        std::pmr::vector<double> ey_; // Diagonale de I + (1 - theta) dt L
+        std::pmr::vector<double> ez_; // Sur-diagonale de I + (1 - theta) dt L
+        double rFacto_; // Taux d'intérêt des coefficients courants (NaN tant qu'aucun n'a été calculé)
+        double sigmaFacto_; // Volatilité des coefficients courants (NaN tant qu'aucun n'a été calculé)
+        double thetaFacto_; // Poids de la partie implicite des coefficients courants (NaN tant qu'aucun n'a été calculé)
+        int lissage_; // Nombre de pas effectués avec le schéma implicite depuis la maturité, pour amortir le coin du payoff
+
+        /**
+         * @brief Calcule les coefficients des deux membres du pas [t_i, t_i+1], s'ils ont changé depuis le pas précédent
+         * @param i Indice du pas de temps
+         */
+        void preparer(int i);
+
+        /**
+         * @brief Applique la partie explicite du schéma sur une plage d'indices d'espace intérieurs
+         * @param suivante Tranche i+1
+         * @param courante Tranche dans laquelle on écrit (I + (1 - theta) dt L) C_i+1
+         * @param debut Premier indice de la plage
+         * @param fin Indice suivant le dernier indice de la plage
+         */
+        void stencil(const double* suivante, double* courante, int debut, int fin) const;
+
+        /**
+         * @brief Effectue un pas de temps du schéma, de la tranche i+1 vers la tranche i
+         * @param i Indice de la tranche de temps à calculer
+         * @param suivante Tranche i+1, déjà calculée
+         * @param courante Tranche i, dont les valeurs aux bords sont déjà renseignées et dont on calcule l'intérieur
+         */
+        void pas(int i, const std::vector<double>& suivante, std::vector<double>& courante);
+
+        /**
+         * @brief Effectue la marche explicite par blocs de pas de temps et tuiles d'espace, lorsque les coefficients sont constants
+         * @param C Matrice initialisée avec les conditions aux bords et terminale
+         */
+        void marcheExpliciteParBlocs(std::vector<std::vector<double>>& C);
+
+        /**
+         * @brief Effectue un pas de temps du schéma pour un bloc de seconds membres entrelacés
+         * @param i Indice de la tranche de temps à calculer
+         * @param nb Nombre de seconds membres
+         * @param suivante Tranches i+1 entrelacées, déjà calculées
+         * @param courante Tranches i entrelacées, dont les valeurs aux bords sont déjà renseignées et dont on calcule l'intérieur
+         */
+        void pasBloc(int i, int nb, const double* suivante, double* courante);
+
+    public:
+        /**
+         * @brief Constructeur de la classe SchemaTheta
+         * @param edp EDP à résoudre, qui fournit l'opérateur L
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param theta Poids de la partie implicite, entre 0 et 1, ou THETA_AUTOMATIQUE pour choisir le schéma le moins coûteux
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        SchemaTheta(EDP& edp, std::shared_ptr<const Maillage> maillage, double theta, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        static constexpr double THETA_AUTOMATIQUE = -1; // Schéma explicite s'il est stable sur le maillage, Crank Nicholson sinon
+
+        /**
+        * @brief Getter du poids de la partie implicite du schéma
+        * @return Valeur de theta
+        */
+        double getTheta() const { return theta_; }
+
+        /**
+         * @brief Vérifie la condition de stabilité du schéma pour tous les pas de temps du maillage
+         * @param theta Poids de la partie implicite à tester
+         * @return Vrai si dt (1 - 2 theta) rho(L) <= 2 à chaque pas, rho(L) étant majoré par les disques de Gershgorin
+         */
+        bool estStable(double theta);
+
+        /**
+         * @brief Méthode qui résout l'EDP avec le theta-schéma
+         * @return Matrice des valeurs de la solution de l'EDP aux différentes valeurs de S et t
+         */
+        std::vector<std::vector<double>> solve();
+
+        /**
+         * @brief Méthode qui résout l'EDP avec le theta-schéma dans une matrice existante
+         *
+         * Si C a déjà les bonnes dimensions (solveur précédent de même taille), aucune allocation n'est faite pour la solution
+         *
+         * @param C Matrice dans laquelle on écrit les valeurs de la solution
+         */
+        void solve(std::vector<std::vector<double>>& C);
+
+        /**
+         * @brief Méthode qui résout l'EDP pour plusieurs options partageant l'opérateur du solveur, par exemple une échelle de strikes
+         *
+         * Les options doivent avoir la même maturité, le même domaine, les mêmes taux et les mêmes volatilités que celle de l'EDP :
+         * seuls leurs payoffs et leurs conditions aux bords diffèrent. Chaque factorisation sert alors à tout le bloc, et les
+         * seconds membres sont entrelacés pour que les substitutions des différentes options se fassent dans la même boucle.
+         * L'observateur reçoit les tranches de la première option
+         *
+         * @param options Options à résoudre
+         * @param C C[p] est la matrice des valeurs de la solution de l'option p aux différentes valeurs de S et t
+         * @return Faux si une option ne partage pas l'opérateur du solveur (C est alors vide)
+         */
+        bool solve(const std::vector<const Option*>& options, std::vector<std::vector<std::vector<double>>>& C);
 };
 
 /**
  * @brief Classe concrète qui implémente la méthode de Crank Nicholson pour résoudre l'EDP complète de Black Scholes
+ *
+ * C'est le theta-schéma avec theta = 1/2, d'ordre 2 en temps : à précision égale, il demande bien moins de pas de temps que
+ * le schéma implicite. Le stencil explicite de chaque pas est appliqué dans la même passe que la descente de Thomas. Le
+ * schéma de Crank Nicholson amortit mal les hautes fréquences : le coin du payoff au strike produirait des oscillations sur
+ * les grands pas de temps. Les PAS_LISSAGE premiers pas depuis la maturité sont donc implicites (démarrage de Rannacher),
+ * ce qui ne change pas l'ordre 2
  */
-class CrankNicholson : public DifferencesFinies 
+class CrankNicholson : public SchemaTheta
 {
     public:
+        static constexpr int PAS_LISSAGE = 2; // Nombre de pas implicites au démarrage depuis la maturité
+
         /**
          * @brief Constructeur de la classe CrankNicholson
          * @param edp EDP complète à résoudre
          * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
          * @param t Valeurs du temps t pour lesquelles on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
          */
-        CrankNicholson(EDPComplete& edp, std::vector<double>& S, std::vector<double>& t);
+        CrankNicholson(EDPComplete& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
 
         /**
-         * @brief Méthode qui résout l'EDP complète en utilisant la méthode de Crank Nicholson
-         * @return Matrice des valeurs de la solution de l'EDP complète aux différentes valeurs de S et t
+         * @brief Constructeur de la classe CrankNicholson sur un maillage partagé
+         * @param edp EDP complète à résoudre
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
          */
-        std::vector<std::vector<double>> solve();
+        CrankNicholson(EDPComplete& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+};
+
+/**
+ * @brief Classe concrète qui résout l'EDP complète par la méthode de Crank Nicholson à la demande, tranche par tranche
+ *
+ * La marche rétrograde ne descend que jusqu'à la tranche la plus ancienne demandée. Les tranches atteintes sont conservées :
+ * une requête à un temps déjà atteint ne coûte rien, et une requête à un temps antérieur reprend depuis la dernière tranche
+ * calculée. Une instance ne doit être utilisée que par un seul thread à la fois
+ */
+class CrankNicholsonParesseux : public CrankNicholson
+{
+    private:
+        std::vector<std::vector<double>> tranches_; // Tranches déjà calculées (vides pour les indices non encore atteints)
+        int iCalcule_; // Indice de la tranche calculée la plus ancienne
+
+    public:
+        /**
+         * @brief Constructeur de la classe CrankNicholsonParesseux : seule la tranche terminale est calculée
+         * @param edp EDP complète à résoudre
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        CrankNicholsonParesseux(EDPComplete& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Méthode qui retourne la tranche i, en poursuivant la marche rétrograde si elle n'a pas encore été atteinte
+         * @param i Indice de la tranche de temps
+         * @return Référence vers les valeurs de la solution aux différentes valeurs de S, valide tant que l'instance existe
+         */
+        const std::vector<double>& tranche(int i);
+
+        /**
+         * @brief Méthode qui retourne la tranche du maillage la plus proche d'un temps donné
+         * @param t Temps auquel on veut la solution (compris entre 0 et T)
+         * @return Référence vers les valeurs de la solution aux différentes valeurs de S
+         */
+        const std::vector<double>& solve(double t);
+
+        /**
+         * @brief Méthode qui retourne le prix en un point, par interpolation linéaire en S sur la tranche la plus proche de t
+         * @param S Valeur de l'actif (comprise entre 0 et L)
+         * @param t Temps (compris entre 0 et T)
+         * @return Prix de l'option
+         */
+        double prix(double S, double t);
+
+        /**
+        * @brief Getter de l'indice de la tranche calculée la plus ancienne
+        * @return Indice de la tranche calculée la plus ancienne (M si seule la condition terminale est connue)
+        */
+        int getIndiceCalcule() const { return iCalcule_; }
 };
 
 /**
  * @brief Classe concrète qui implémente la méthode Implicite pour résoudre l'EDP réduite de Black Scholes
  */
-class Implicite : public DifferencesFinies 
+class Implicite : public SchemaTheta
 {
     public:
         /**
@@ -97,14 +378,218 @@ class Implicite : public DifferencesFinies
          * @param edp EDP réduite à résoudre
          * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
          * @param t Valeurs du temps t pour lesquelles on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        Implicite(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Constructeur de la classe Implicite sur un maillage partagé
+         * @param edp EDP réduite à résoudre
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        Implicite(EDPReduite& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+};
+
+/**
+ * @brief Classe concrète qui résout une EDP par le schéma de Crank Nicholson avec un pas de temps adaptatif contrôlé par l'erreur
+ *
+ * La solution n'est raide qu'à proximité de la maturité : la marche part du pas du maillage et l'augmente tant que l'erreur
+ * locale le permet. Chaque pas h est comparé à deux demi-pas h / 2 (doublement de pas) : leur écart estime l'erreur locale,
+ * qui doit rester sous tolerance * h / T pour que l'erreur globale reste sous la tolérance. Les pas sont pris dans l'échelle
+ * dt 2^k, de sorte que seules quelques factorisations distinctes sont calculées et gardées en cache. Seul l'axe de l'actif,
+ * la maturité et le pas de temps du maillage sont utilisés
+ */
+class SchemaAdaptatif : public DifferencesFinies
+{
+    private:
+        /**
+         * @brief Structure contenant les deux membres du schéma pour un pas de l'échelle
+         */
+        struct Niveau
+        {
+            FactorisationThomas f; // Décomposition LU de I - h/2 L
+            std::pmr::vector<double> ex; // Sous-diagonale de I + h/2 L
+            std::pmr::vector<double> ey; // Diagonale de I + h/2 L
+            std::pmr::vector<double> ez; // Sur-diagonale de I + h/2 L
+
+            /**
+             * @brief Constructeur de la structure Niveau
+             * @param n Taille des matrices
+             * @param memoire Ressource mémoire des vecteurs
+             */
+            Niveau(int n, std::pmr::memory_resource* memoire) : f(n, memoire), ex(n, memoire), ey(n, memoire), ez(n, memoire) {}
+        };
+
+        double tolerance_; // Erreur en temps visée sur la solution à t = 0
+        std::pmr::map<int, Niveau> cache_; // Membres du schéma pour le pas dt 2^k, par niveau k
+        double rCache_; // Taux d'intérêt des niveaux en cache (NaN si le cache est vide)
+        double sigmaCache_; // Volatilité des niveaux en cache (NaN si le cache est vide)
+        std::pmr::vector<double> poids_; // dS / sqrt(4 pi D_j), pour estimer l'effet d'une erreur locale après diffusion
+        std::vector<double> temps_; // Temps des tranches calculées, croissants
+        int nbFactorisations_; // Nombre de factorisations calculées par le dernier solve
+        int nbRejets_; // Nombre de pas rejetés par le dernier solve
+
+        /**
+         * @brief Retourne les membres du schéma pour un niveau, en les calculant s'ils ne sont pas en cache
+         * @param k Niveau du pas dt 2^k
+         * @param r Taux d'intérêt sur le pas
+         * @param sigma Volatilité sur le pas
+         * @return Référence vers les membres du schéma
+         */
+        const Niveau& niveau(int k, double r, double sigma);
+
+        /**
+         * @brief Effectue un pas de Crank Nicholson
+         * @param n Membres du schéma du pas
+         * @param suivante Tranche de départ, au temps t + h
+         * @param courante Tranche calculée, au temps t
+         * @param t Temps d'arrivée, pour les conditions aux bords
+         */
+        void pas(const Niveau& n, const double* suivante, double* courante, double t);
+
+    public:
+        /**
+         * @brief Constructeur de la classe SchemaAdaptatif
+         * @param edp EDP à résoudre, qui fournit l'opérateur L
+         * @param maillage Maillage dont on utilise l'axe de l'actif, la maturité et le pas de temps, qui sert de pas initial
+         * @param tolerance Erreur en temps visée sur la solution à t = 0
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        SchemaAdaptatif(EDP& edp, std::shared_ptr<const Maillage> maillage, double tolerance,
+                        std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Méthode qui résout l'EDP avec le pas de temps adaptatif
+         *
+         * La ligne i de la matrice retournée est la solution au temps getTemps()[i]. L'observateur n'est pas appelé, les
+         * indices des tranches n'étant connus qu'à la fin de la marche
+         *
+         * @return Matrice des valeurs de la solution de l'EDP, de t = 0 à t = T
+         */
+        std::vector<std::vector<double>> solve();
+
+        /**
+        * @brief Getter des temps des tranches calculées par le dernier solve
+        * @return Référence constante vers les temps, croissants de 0 à T
+        */
+        const std::vector<double>& getTemps() const { return temps_; }
+
+        /**
+        * @brief Getter du nombre de pas acceptés par le dernier solve
+        * @return Nombre de pas de temps
+        */
+        int getNbPas() const { return static_cast<int>(temps_.size()) - 1; }
+
+        /**
+        * @brief Getter du nombre de pas rejetés par le dernier solve
+        * @return Nombre de pas rejetés
+        */
+        int getNbRejets() const { return nbRejets_; }
+
+        /**
+        * @brief Getter du nombre de factorisations calculées par le dernier solve
+        * @return Nombre de factorisations
+        */
+        int getNbFactorisations() const { return nbFactorisations_; }
+};
+
+/**
+ * @brief Classe concrète qui résout l'EDP réduite de Black Scholes à l'aide du noyau exact de l'équation de la chaleur
+ *
+ * Lorsque les coefficients sont constants, chaque tranche de temps est obtenue directement à partir de la condition terminale
+ * par convolution avec le noyau gaussien (calculée par FFT en O(N log N)), sans parcourir les M pas de temps.
+ * Sinon, on se rabat sur la méthode Implicite, dont la solution est calculée à la première demande puis gardée pour les
+ * tranches suivantes
+ */
+class NoyauChaleur : public DifferencesFinies
+{
+    private:
+        EDPReduite& edpReduite_; // EDP réduite à résoudre, utilisée par la méthode Implicite de repli
+        int marge_; // Nombre de points ajoutés de chaque côté de la grille pour éviter le repliement de la convolution
+        std::pmr::vector<std::complex<double>> terminalFFT_; // Transformée de Fourier de la condition terminale prolongée
+        std::vector<std::vector<double>> repli_; // Solution de la méthode Implicite de repli, calculée à la première demande (vide sinon)
+
+        /**
+         * @brief Calcule une seule fois la solution de la méthode Implicite de repli, utilisée lorsque les coefficients ne sont pas constants
+         * @param avecObservateur Vrai pour transmettre à l'observateur les tranches au fur et à mesure de la marche
+         * @return Référence vers la solution de repli
+         */
+        const std::vector<std::vector<double>>& repli(bool avecObservateur);
+
+    public:
+        /**
+         * @brief Constructeur de la classe NoyauChaleur
+         * @param edp EDP réduite à résoudre
+         * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
+         * @param t Valeurs du temps t pour lesquelles on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
          */
-        Implicite(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t);
+        NoyauChaleur(EDPReduite& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
 
         /**
-         * @brief Méthode qui résout l'EDP réduite en utilisant la méthode Implicite
+         * @brief Constructeur de la classe NoyauChaleur sur un maillage partagé
+         * @param edp EDP réduite à résoudre
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        NoyauChaleur(EDPReduite& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Méthode qui calcule directement la solution de l'EDP réduite à un temps donné
+         * @param t Temps auquel on calcule la solution (compris entre 0 et T)
+         * @return Vecteur des valeurs de la solution de l'EDP réduite aux différentes valeurs de S au temps t
+         */
+        std::vector<double> solve(double t);
+
+        /**
+         * @brief Méthode qui résout l'EDP réduite pour toutes les valeurs de t
          * @return Matrice des valeurs de la solution de l'EDP réduite aux différentes valeurs de S et t
          */
         std::vector<std::vector<double>> solve();
 };
 
+/**
+ * @brief Classe concrète qui implémente la méthode de Crank Nicholson pour l'EDP complète avec une volatilité locale sigma(S, t)
+ *
+ * La surface est échantillonnée une fois sur la grille, tranche de temps par tranche de temps de façon contiguë, puis chaque pas
+ * de temps assemble les coefficients, applique le stencil explicite et effectue la descente de Thomas dans une seule passe sur
+ * la mémoire. Comme pour CrankNicholson, les premiers pas depuis la maturité sont implicites
+ */
+class CrankNicholsonVolLocale : public DifferencesFinies
+{
+    private:
+        std::pmr::vector<double> sigma2_; // Carré de la volatilité locale aux noeuds de la grille, indice i * (N+1) + j
+
+    public:
+        /**
+         * @brief Constructeur de la classe CrankNicholsonVolLocale
+         * @param edp EDP complète avec volatilité locale à résoudre
+         * @param S Valeurs de l'actif S pour lesquelles on calcule la solution
+         * @param t Valeurs du temps t pour lesquelles on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        CrankNicholsonVolLocale(EDPVolLocale& edp, std::vector<double>& S, std::vector<double>& t, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Constructeur de la classe CrankNicholsonVolLocale sur un maillage partagé
+         * @param edp EDP complète avec volatilité locale à résoudre
+         * @param maillage Maillage sur lequel on calcule la solution
+         * @param memoire Ressource mémoire des vecteurs de travail du solveur
+         */
+        CrankNicholsonVolLocale(EDPVolLocale& edp, std::shared_ptr<const Maillage> maillage, std::pmr::memory_resource* memoire = std::pmr::get_default_resource());
+
+        /**
+         * @brief Méthode qui résout l'EDP complète avec volatilité locale en utilisant la méthode de Crank Nicholson
+         * @return Matrice des valeurs de la solution de l'EDP aux différentes valeurs de S et t
+         */
+        std::vector<std::vector<double>> solve();
+
+        /**
+         * @brief Méthode qui résout l'EDP complète avec volatilité locale en utilisant la méthode de Crank Nicholson dans une matrice existante
+         * @param C Matrice dans laquelle on écrit les valeurs de la solution
+         */
+        void solve(std::vector<std::vector<double>>& C);
+};
+
 #endif  // DIFF_FINIES_H
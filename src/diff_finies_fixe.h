@@ -0,0 +1,167 @@
+/**
+ * @file diff_finies_fixe.h
+ * @brief Déclaration et implémentation de la classe CrankNicholsonFixe, solveur de taille fixée à la compilation
+ */
+
+#ifndef DIFF_FINIES_FIXE_H
+#define DIFF_FINIES_FIXE_H
+
+#include "edp.h" // Pour la déclaration de la classe EDPComplete
+#include "diff_finies.h" // Pour CrankNicholson::PAS_LISSAGE
+
+#include <array> // Pour std::array
+#include <cmath> // Pour std::nan
+#include <algorithm> // Pour std::min
+
+/**
+ * @brief Classe qui résout l'EDP complète par le même schéma que CrankNicholson (theta = 1/2 avec démarrage implicite), sur une grille uniforme de taille fixée à la compilation
+ *
+ * Destinée aux petites grilles de cotation : toutes les données de travail sont des std::array membres ou locaux, de sorte
+ * qu'une résolution ne fait aucune allocation. Seules les deux dernières tranches de temps sont gardées, la solution
+ * retenue étant la tranche t = 0. Les tables d'indices j et j^2 sont calculées à la compilation et les boucles de l'algorithme
+ * de Thomas ont un nombre d'itérations constant, que le compilateur peut dérouler
+ *
+ * @tparam M Nombre de pas de temps
+ * @tparam N Nombre de pas d'espace
+ */
+template <int M, int N>
+class CrankNicholsonFixe
+{
+    static_assert(M > 0 && N > 1, "CrankNicholsonFixe demande au moins un pas de temps et deux pas d'espace");
+
+    private:
+        /**
+        * @brief Calcule la table des indices d'espace, élevés à une puissance donnée
+        * @param puissance 1 pour j, 2 pour j^2
+        * @return Table des j^puissance pour j de 0 à N
+        */
+        static constexpr std::array<double, N+1> tableIndices(int puissance)
+        {
+            std::array<double, N+1> table = {};
+            for (int j = 0; j <= N; j++)
+            {
+                table[j] = puissance == 1 ? j : static_cast<double>(j) * j;
+            }
+            return table;
+        }
+
+        static constexpr std::array<double, N+1> j_ = tableIndices(1); // Indices d'espace j
+        static constexpr std::array<double, N+1> j2_ = tableIndices(2); // Carrés des indices d'espace j^2
+
+        EDPComplete& edp_; // Référence vers l'EDP complète à résoudre
+        double dt_; // Pas de temps
+        double dS_; // Pas d'espace
+        std::array<double, N+1> tranche_; // Solution au temps t = 0 après solve
+
+    public:
+        /**
+        * @brief Constructeur de la classe CrankNicholsonFixe
+        * @param edp EDP complète à résoudre, sur [0, T] x [0, L]
+        */
+        CrankNicholsonFixe(EDPComplete& edp)
+            : edp_(edp), dt_(edp.getOption().getT() / M), dS_(edp.getOption().getL() / N), tranche_() {}
+
+        /**
+        * @brief Getter de la solution au temps t = 0
+        * @return Référence constante vers la tranche t = 0, valide après solve
+        */
+        const std::array<double, N+1>& getTranche() const { return tranche_; }
+
+        /**
+        * @brief Méthode qui résout l'EDP et garde la tranche t = 0
+        */
+        void solve()
+        {
+            const Option& option = edp_.getOption();
+            double T = option.getT();
+
+            // Factorisation LU de la partie implicite du pas de temps et coefficients de sa partie explicite, sur la pile. On
+            // garde m et x m plutôt que x : la descente n'a plus qu'un produit et une soustraction dans sa chaîne de dépendance
+            std::array<double, N+1> xm, c, m, ex, ey, ez;
+            double rFacto = std::nan("");
+            double sigmaFacto = std::nan("");
+            double thetaFacto = std::nan("");
+
+            // N dS peut différer de L d'un ulp, et les payoffs reconnaissent le bord S = L par une égalité exacte : le dernier
+            // noeud est L lui-même, dans la tranche terminale comme dans les conditions aux bords de chaque pas
+            double L = option.getL();
+            for (int j = 0; j < N; j++)
+            {
+                tranche_[j] = option.payoff(j * dS_, T);
+            }
+            tranche_[N] = option.payoff(L, T);
+
+            for (int i = M-1; i >= 0; i--)
+            {
+                // La factorisation n'est recalculée que si r, sigma ou theta changent. Comme pour CrankNicholson, les premiers pas
+                // depuis la maturité sont implicites pour amortir le coin du payoff
+                double t = i * T / M;
+                double r = option.getR(t);
+                double sigma = option.getSigma(t);
+                double theta = i >= M - CrankNicholson::PAS_LISSAGE ? 1 : 0.5;
+                if (r != rFacto || sigma != sigmaFacto || theta != thetaFacto)
+                {
+                    double sigma2 = sigma * sigma;
+                    xm[0] = 0;
+                    m[0] = 1;
+                    c[0] = 0;
+                    for (int j = 1; j < N; j++)
+                    {
+                        // (I - theta dt L) C_i = (I + (1 - theta) dt L) C_i+1, dans le même ordre d'opérations que SchemaTheta
+                        double a = 0.5 * (sigma2 * j2_[j] - r * j_[j]);
+                        double b = -(sigma2 * j2_[j] + r);
+                        double d = 0.5 * (sigma2 * j2_[j] + r * j_[j]);
+                        double x = -theta * dt_ * a;
+                        m[j] = 1.0 / (1 - theta * dt_ * b - x * c[j-1]);
+                        xm[j] = x * m[j];
+                        c[j] = -theta * dt_ * d * m[j];
+                        ex[j] = (1 - theta) * dt_ * a;
+                        ey[j] = 1 + (1 - theta) * dt_ * b;
+                        ez[j] = (1 - theta) * dt_ * d;
+                    }
+                    xm[N] = 0;
+                    m[N] = 1;
+                    c[N] = 0;
+                    rFacto = r;
+                    sigmaFacto = sigma;
+                    thetaFacto = theta;
+                }
+
+                // Descente en place : le second membre de la ligne j est le stencil explicite sur la tranche suivante, dont la
+                // valeur en j - 1 vient d'être écrasée et est gardée dans gauche. Les bords prennent les conditions du temps courant
+                double gauche = tranche_[0];
+                tranche_[0] = option.payoff(0, t);
+                for (int j = 1; j < N; j++)
+                {
+                    double centre = tranche_[j];
+                    double b = ex[j] * gauche + ey[j] * centre + ez[j] * tranche_[j+1];
+                    tranche_[j] = b * m[j] - xm[j] * tranche_[j-1];
+                    gauche = centre;
+                }
+                tranche_[N] = option.payoff(L, t);
+                for (int j = N-1; j > 0; j--)
+                {
+                    tranche_[j] -= c[j] * tranche_[j+1];
+                }
+            }
+        }
+
+        /**
+        * @brief Prix de l'option au temps t = 0, par interpolation linéaire de la tranche calculée
+        * @param S Valeur de l'actif, entre 0 et L
+        * @return Prix interpolé, ou NaN si S sort du domaine
+        */
+        double prix(double S) const
+        {
+            if (S < 0 || S > edp_.getOption().getL())
+            {
+                return std::nan("");
+            }
+            double u = std::min(S / dS_, static_cast<double>(N));
+            int j = u < N ? static_cast<int>(u) : N-1;
+            double a = u - j;
+            return (1 - a) * tranche_[j] + a * tranche_[j+1];
+        }
+};
+
+#endif // DIFF_FINIES_FIXE_H
@@ -1,6 +1,6 @@
 /**
  * @file edp.cpp
- * @brief Implémentation de la classe abstraite EDP et de ses classes concrètes EDPComplete et EDPReduite
+ * @brief Implémentation de la classe abstraite EDP et de ses classes concrètes EDPComplete, EDPReduite et EDPVolLocale
  */
 
 #include "edp.h" // Pour la déclaration de la classe EDP
@@ -17,8 +17,54 @@ EDP::EDP(const Option& option) : option_(option) {}
  */
 EDPComplete::EDPComplete(const Option& option) : EDP(option) {}
 
+/**
+* @brief Donne la ligne j de l'opérateur de Black-Scholes, en différences centrées sur une grille uniforme S_j = j dS
+* @param maillage Maillage de la discrétisation
+* @param j Indice d'espace intérieur
+* @param r Taux d'intérêt sur le pas de temps
+* @param sigma Volatilité sur le pas de temps
+* @param a Coefficient de C_j-1
+* @param b Coefficient de C_j
+* @param c Coefficient de C_j+1
+ */
+void EDPComplete::operateur(const Maillage& maillage, int j, double r, double sigma, double& a, double& b, double& c) const
+{
+    // Avec S_j = j dS, les facteurs S^2 / dS^2 et S / dS se réduisent à j^2 et j
+    double sigma2 = sigma * sigma;
+    double j1 = maillage.getIndices()[j];
+    double j2 = maillage.getIndicesCarres()[j];
+    a = 0.5 * (sigma2 * j2 - r * j1);
+    b = -(sigma2 * j2 + r);
+    c = 0.5 * (sigma2 * j2 + r * j1);
+}
+
 /**
  * @brief Constructeur de la classe EDPReduite
  * @param option Option associée à l'EDP
  */
 EDPReduite::EDPReduite(const Option& option) : EDP(option) {}
+
+/**
+* @brief Donne la ligne j de l'opérateur de la chaleur, en différences centrées
+* @param maillage Maillage de la discrétisation
+* @param j Indice d'espace intérieur
+* @param r Taux d'intérêt sur le pas de temps (absent de l'EDP réduite)
+* @param sigma Volatilité sur le pas de temps
+* @param a Coefficient de u_j-1
+* @param b Coefficient de u_j
+* @param c Coefficient de u_j+1
+ */
+void EDPReduite::operateur(const Maillage& maillage, int /* j */, double /* r */, double sigma, double& a, double& b, double& c) const
+{
+    double k = 0.5 * sigma * sigma * maillage.getInvDS2();
+    a = k;
+    b = -2 * k;
+    c = k;
+}
+
+/**
+ * @brief Constructeur de la classe EDPVolLocale
+ * @param option Option associée à l'EDP
+ * @param volLocale Surface de volatilité locale sigma(S, t)
+ */
+EDPVolLocale::EDPVolLocale(const Option& option, std::function<double(double, double)> volLocale) : EDPComplete(option), volLocale_(volLocale) {}
@@ -1,12 +1,15 @@
 /**
  * @file edp.h
- * @brief Déclarations de la classe abstraite EDP et de ses classes concrètes EDPComplète et EDPRéduite
+ * @brief Déclarations de la classe abstraite EDP et de ses classes concrètes EDPComplète, EDPRéduite et EDPVolLocale
  */
 
 #ifndef EDP_H
 #define EDP_H
 
 #include "option.h" // Pour la déclaration de la classe Option
+#include "maillage.h" // Pour la déclaration de la classe Maillage
+
+#include <functional> // Pour std::function
 
 /**
  * @brief Classe abstraite représentant une équation différentielle aux dérivées partielles pour une option
@@ -23,11 +26,28 @@ class EDP
         */
         EDP(const Option& option);
 
+        /**
+        * @brief Destructeur virtuel de la classe EDP
+        */
+        virtual ~EDP() = default;
+
         /**
         * @brief Getter de l'option associée à l'EDP
         * @return Référence constante vers l'option associée à l'EDP
         */
         const Option& getOption() const { return option_; }
+
+        /**
+        * @brief Donne la ligne j de l'opérateur spatial L discrétisé, l'EDP s'écrivant dC/dtau = L C en temps rétrograde
+        * @param maillage Maillage de la discrétisation
+        * @param j Indice d'espace intérieur
+        * @param r Taux d'intérêt sur le pas de temps
+        * @param sigma Volatilité sur le pas de temps
+        * @param a Coefficient de C_j-1
+        * @param b Coefficient de C_j
+        * @param c Coefficient de C_j+1
+        */
+        virtual void operateur(const Maillage& maillage, int j, double r, double sigma, double& a, double& b, double& c) const = 0;
 };
 
 /**
@@ -41,6 +61,18 @@ class EDPComplete : public EDP
         * @param option Option associée à l'EDP
         */
         EDPComplete(const Option& option);
+
+        /**
+        * @brief Donne la ligne j de l'opérateur de Black-Scholes 1/2 sigma^2 S^2 d2C/dS2 + r S dC/dS - r C
+        * @param maillage Maillage de la discrétisation
+        * @param j Indice d'espace intérieur
+        * @param r Taux d'intérêt sur le pas de temps
+        * @param sigma Volatilité sur le pas de temps
+        * @param a Coefficient de C_j-1
+        * @param b Coefficient de C_j
+        * @param c Coefficient de C_j+1
+        */
+        void operateur(const Maillage& maillage, int j, double r, double sigma, double& a, double& b, double& c) const override;
 };
 
 /**
@@ -54,6 +86,43 @@ class EDPReduite : public EDP
         * @param option Option associée à l'EDP
         */
         EDPReduite(const Option& option);
+
+        /**
+        * @brief Donne la ligne j de l'opérateur de la chaleur 1/2 sigma^2 d2u/dx2
+        * @param maillage Maillage de la discrétisation
+        * @param j Indice d'espace intérieur
+        * @param r Taux d'intérêt sur le pas de temps (absent de l'EDP réduite)
+        * @param sigma Volatilité sur le pas de temps
+        * @param a Coefficient de u_j-1
+        * @param b Coefficient de u_j
+        * @param c Coefficient de u_j+1
+        */
+        void operateur(const Maillage& maillage, int j, double r, double sigma, double& a, double& b, double& c) const override;
+};
+
+/**
+ * @brief Classe concrète représentant l'EDP complète avec une surface de volatilité locale sigma(S, t)
+ */
+class EDPVolLocale : public EDPComplete
+{
+    private:
+        std::function<double(double, double)> volLocale_; // Surface de volatilité locale sigma(S, t)
+
+    public:
+        /**
+        * @brief Constructeur de la classe EDPVolLocale
+        * @param option Option associée à l'EDP
+        * @param volLocale Surface de volatilité locale sigma(S, t)
+        */
+        EDPVolLocale(const Option& option, std::function<double(double, double)> volLocale);
+
+        /**
+        * @brief Évalue la surface de volatilité locale
+        * @param S Valeur de l'actif
+        * @param t Valeur du temps t
+        * @return Volatilité locale sigma(S, t)
+        */
+        double getVolLocale(double S, double t) const { return volLocale_(S, t); }
 };
 
 #endif  // EDP_H
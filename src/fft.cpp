@@ -0,0 +1,88 @@
+/**
+ * @file fft.cpp
+ * @brief Implémentation de la transformée de Fourier rapide utilisée par le solveur à noyau de la chaleur
+ */
+
+#include "fft.h" // Pour la déclaration de la méthode fft
+
+#include <cmath> // Pour std::acos
+#include <utility> // Pour std::swap
+
+/**
+ * @brief Méthode qui calcule en place la transformée de Fourier discrète d'un vecteur par l'algorithme de Cooley-Tukey
+ * @param a Vecteur à transformer, dont la taille doit être une puissance de 2
+ * @param inverse Vrai pour calculer la transformée inverse (normalisée par la taille du vecteur)
+ */
+void fft(std::vector<std::complex<double>>& a, bool inverse)
+{
+    fft(a.data(), a.size(), inverse);
+}
+
+/**
+ * @brief Méthode qui calcule en place la transformée de Fourier discrète d'un tableau, quel que soit l'allocateur qui le contient
+ * @param a Pointeur vers le premier élément du tableau à transformer
+ * @param n Taille du tableau, qui doit être une puissance de 2
+ * @param inverse Vrai pour calculer la transformée inverse (normalisée par la taille du tableau)
+ */
+void fft(std::complex<double>* a, int n, bool inverse)
+{
+    // On permute les éléments selon l'ordre des indices à bits inversés
+    for (int i = 1, j = 0; i < n; i++)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            std::swap(a[i], a[j]);
+        }
+    }
+
+    // On combine les transformées de taille len / 2 en transformées de taille len
+    const double pi = std::acos(-1.0);
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        double angle = 2 * pi / len * (inverse ? 1 : -1);
+        std::complex<double> wlen(std::cos(angle), std::sin(angle));
+        for (int i = 0; i < n; i += len)
+        {
+            std::complex<double> w(1);
+            for (int j = 0; j < len / 2; j++)
+            {
+                std::complex<double> u = a[i+j];
+                std::complex<double> v = a[i+j+len/2] * w;
+                a[i+j] = u + v;
+                a[i+j+len/2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+
+    // On normalise la transformée inverse
+    if (inverse)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            a[i] /= n;
+        }
+    }
+}
+
+/**
+ * @brief Méthode qui retourne la plus petite puissance de 2 supérieure ou égale à n
+ * @param n Taille minimale
+ * @return Puissance de 2 supérieure ou égale à n
+ */
+int puissanceDeDeux(int n)
+{
+    int p = 1;
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file fft.h
+ * @brief Déclaration de la transformée de Fourier rapide utilisée par le solveur à noyau de la chaleur
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <vector> // Pour std::vector
+#include <complex> // Pour std::complex
+
+/**
+ * @brief Méthode qui calcule en place la transformée de Fourier discrète d'un vecteur par l'algorithme de Cooley-Tukey
+ * @param a Vecteur à transformer, dont la taille doit être une puissance de 2
+ * @param inverse Vrai pour calculer la transformée inverse (normalisée par la taille du vecteur)
+ */
+void fft(std::vector<std::complex<double>>& a, bool inverse);
+
+/**
+ * @brief Méthode qui calcule en place la transformée de Fourier discrète d'un tableau, quel que soit l'allocateur qui le contient
+ * @param a Pointeur vers le premier élément du tableau à transformer
+ * @param n Taille du tableau, qui doit être une puissance de 2
+ * @param inverse Vrai pour calculer la transformée inverse (normalisée par la taille du tableau)
+ */
+void fft(std::complex<double>* a, int n, bool inverse);
+
+/**
+ * @brief Méthode qui retourne la plus petite puissance de 2 supérieure ou égale à n
+ * @param n Taille minimale
+ * @return Puissance de 2 supérieure ou égale à n
+ */
+int puissanceDeDeux(int n);
+
+#endif // FFT_H
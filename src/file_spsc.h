@@ -0,0 +1,79 @@
+/**
+ * @file file_spsc.h
+ * @brief Déclaration et implémentation de la file sans verrou à un producteur et un consommateur FileSPSC
+ */
+
+#ifndef FILE_SPSC_H
+#define FILE_SPSC_H
+
+#include <vector> // Pour std::vector
+#include <atomic> // Pour std::atomic
+#include <cstddef> // Pour std::size_t
+#include <utility> // Pour std::move
+
+/**
+ * @brief File circulaire sans verrou permettant à un seul thread producteur de transmettre des éléments à un seul thread consommateur
+ */
+template <typename T>
+class FileSPSC
+{
+    private:
+        std::vector<T> tampon_; // Tampon circulaire dont la taille est une puissance de 2
+        std::size_t masque_; // Taille du tampon moins 1, pour calculer les indices modulo la taille
+        alignas(64) std::atomic<std::size_t> tete_; // Nombre d'éléments lus par le consommateur
+        alignas(64) std::atomic<std::size_t> queue_; // Nombre d'éléments écrits par le producteur
+
+    public:
+        /**
+        * @brief Constructeur de la classe FileSPSC
+        * @param capacite Nombre minimal d'éléments que la file peut contenir (arrondi à la puissance de 2 supérieure)
+        */
+        FileSPSC(std::size_t capacite) : tete_(0), queue_(0)
+        {
+            std::size_t taille = 1;
+            while (taille < capacite)
+            {
+                taille <<= 1;
+            }
+            tampon_.resize(taille);
+            masque_ = taille - 1;
+        }
+
+        /**
+        * @brief Ajoute un élément à la file (appelé uniquement par le producteur)
+        * @param valeur Élément à ajouter
+        * @return Vrai si l'élément a été ajouté, faux si la file est pleine
+        */
+        bool push(T valeur)
+        {
+            std::size_t queue = queue_.load(std::memory_order_relaxed);
+            if (queue - tete_.load(std::memory_order_acquire) > masque_)
+            {
+                return false;
+            }
+
+            tampon_[queue & masque_] = std::move(valeur);
+            queue_.store(queue + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+        * @brief Retire un élément de la file (appelé uniquement par le consommateur)
+        * @param valeur Élément retiré
+        * @return Vrai si un élément a été retiré, faux si la file est vide
+        */
+        bool pop(T& valeur)
+        {
+            std::size_t tete = tete_.load(std::memory_order_relaxed);
+            if (tete == queue_.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            valeur = std::move(tampon_[tete & masque_]);
+            tete_.store(tete + 1, std::memory_order_release);
+            return true;
+        }
+};
+
+#endif // FILE_SPSC_H
@@ -0,0 +1,256 @@
+/**
+ * @file instantane.cpp
+ * @brief Implémentation de l'écriture des instantanés et de la classe Instantane
+ */
+
+#include "instantane.h" // Pour la déclaration de la classe Instantane
+#include "option.h" // Pour les déclarations des classes Put et Call
+
+#include <fstream> // Pour std::ofstream
+#include <iostream> // Pour std::cout et std::endl
+#include <cstring> // Pour std::memcpy, std::memset et std::strncmp
+#include <algorithm> // Pour std::upper_bound et std::min
+#include <cmath> // Pour std::nan
+
+#include <fcntl.h> // Pour open
+#include <sys/mman.h> // Pour mmap et munmap
+#include <sys/stat.h> // Pour fstat
+#include <unistd.h> // Pour close
+
+/**
+ * @brief Arrondit une taille au multiple supérieur de l'alignement des blocs
+ * @param taille Taille en octets
+ * @return Taille arrondie
+ */
+static std::uint64_t aligner(std::uint64_t taille)
+{
+    return (taille + ALIGNEMENT_INSTANTANE - 1) / ALIGNEMENT_INSTANTANE * ALIGNEMENT_INSTANTANE;
+}
+
+/**
+ * @brief Écrit des octets nuls jusqu'au prochain multiple de l'alignement
+ * @param fichier Fichier en cours d'écriture
+ */
+static void completer(std::ofstream& fichier)
+{
+    static const char zeros[ALIGNEMENT_INSTANTANE] = {};
+    std::uint64_t position = fichier.tellp();
+    fichier.write(zeros, aligner(position) - position);
+}
+
+/**
+ * @brief Écrit un instantané des grilles solution dans un fichier
+ * @param chemin Chemin du fichier à écrire
+ * @param option Option dont les grilles sont la solution
+ * @param schema Schéma numérique ayant produit les grilles
+ * @param t Valeurs de temps t des lignes des grilles
+ * @param S Valeurs de l'actif S des colonnes des grilles
+ * @param noms Noms des grilles (au plus 31 caractères)
+ * @param grilles Pointeurs vers les grilles, chacune de taille t.size() x S.size()
+ * @return Vrai si l'écriture s'est bien déroulée
+ */
+bool ecrireInstantane(const std::string& chemin, const Option& option, Schema schema, const std::vector<double>& t, const std::vector<double>& S,
+                      const std::vector<std::string>& noms, const std::vector<const std::vector<std::vector<double>>*>& grilles)
+{
+    // On vérifie la cohérence des grilles avec les axes
+    if (noms.size() != grilles.size())
+    {
+        std::cout << "Erreur : chaque grille de l'instantané doit avoir un nom" << std::endl;
+        return false;
+    }
+    for (const auto* grille : grilles)
+    {
+        if (grille->size() != t.size() || (!grille->empty() && (*grille)[0].size() != S.size()))
+        {
+            std::cout << "Erreur : les dimensions d'une grille ne correspondent pas aux axes de l'instantané" << std::endl;
+            return false;
+        }
+    }
+
+    // Construction de l'en-tête
+    EnteteInstantane entete;
+    std::memset(&entete, 0, sizeof(entete));
+    std::memcpy(entete.magie, "BSGRILLE", 8);
+    entete.version = VERSION_INSTANTANE;
+    entete.schema = static_cast<std::uint32_t>(schema);
+    entete.typeOption = dynamic_cast<const Put*>(&option) ? 0 : dynamic_cast<const Call*>(&option) ? 1 : 2;
+    entete.nbGrilles = grilles.size();
+    entete.nbTemps = t.size();
+    entete.nbActif = S.size();
+    entete.K = option.getK();
+    entete.T = option.getT();
+    entete.L = option.getL();
+    entete.r = option.getR();
+    entete.sigma = option.getSigma();
+    entete.decalageNoms = aligner(sizeof(EnteteInstantane));
+    entete.decalageTemps = aligner(entete.decalageNoms + grilles.size() * TAILLE_NOM_GRILLE);
+    entete.decalageActif = aligner(entete.decalageTemps + t.size() * sizeof(double));
+    entete.decalageGrilles = aligner(entete.decalageActif + S.size() * sizeof(double));
+    entete.tailleGrille = aligner(t.size() * S.size() * sizeof(double));
+
+    std::ofstream fichier(chemin, std::ios::binary | std::ios::trunc);
+    if (!fichier)
+    {
+        std::cout << "Erreur lors de la création de l'instantané : " << chemin << std::endl;
+        return false;
+    }
+
+    fichier.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    completer(fichier);
+
+    // Table des noms
+    for (const auto& nom : noms)
+    {
+        char tampon[TAILLE_NOM_GRILLE] = {};
+        std::memcpy(tampon, nom.data(), std::min(nom.size(), TAILLE_NOM_GRILLE - 1));
+        fichier.write(tampon, TAILLE_NOM_GRILLE);
+    }
+    completer(fichier);
+
+    // Axes
+    fichier.write(reinterpret_cast<const char*>(t.data()), t.size() * sizeof(double));
+    completer(fichier);
+    fichier.write(reinterpret_cast<const char*>(S.data()), S.size() * sizeof(double));
+    completer(fichier);
+
+    // Grilles, ligne par ligne
+    for (const auto* grille : grilles)
+    {
+        for (const auto& ligne : *grille)
+        {
+            fichier.write(reinterpret_cast<const char*>(ligne.data()), ligne.size() * sizeof(double));
+        }
+        completer(fichier);
+    }
+
+    if (!fichier)
+    {
+        std::cout << "Erreur lors de l'écriture de l'instantané : " << chemin << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Constructeur de la classe Instantane : projette le fichier en mémoire et vérifie son en-tête
+ * @param chemin Chemin du fichier à lire
+ */
+Instantane::Instantane(const std::string& chemin) : donnees_(nullptr), taille_(0)
+{
+    int fd = open(chemin.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cout << "Erreur lors de l'ouverture de l'instantané : " << chemin << std::endl;
+        return;
+    }
+
+    struct stat informations;
+    if (fstat(fd, &informations) != 0 || static_cast<std::size_t>(informations.st_size) < sizeof(EnteteInstantane))
+    {
+        std::cout << "Erreur : l'instantané est trop court : " << chemin << std::endl;
+        close(fd);
+        return;
+    }
+
+    // Le fichier reste accessible à travers la projection une fois le descripteur fermé
+    taille_ = informations.st_size;
+    void* projection = mmap(nullptr, taille_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (projection == MAP_FAILED)
+    {
+        std::cout << "Erreur lors de la projection en mémoire de l'instantané : " << chemin << std::endl;
+        return;
+    }
+    donnees_ = static_cast<const unsigned char*>(projection);
+
+    // On vérifie la signature, la version et que tous les blocs sont contenus dans le fichier
+    const EnteteInstantane& entete = getEntete();
+    bool valide = std::strncmp(entete.magie, "BSGRILLE", 8) == 0
+               && entete.version == VERSION_INSTANTANE
+               && entete.decalageNoms + entete.nbGrilles * TAILLE_NOM_GRILLE <= taille_
+               && entete.decalageTemps + entete.nbTemps * sizeof(double) <= taille_
+               && entete.decalageActif + entete.nbActif * sizeof(double) <= taille_
+               && entete.tailleGrille >= entete.nbTemps * entete.nbActif * sizeof(double)
+               && entete.decalageGrilles + entete.nbGrilles * entete.tailleGrille <= taille_;
+    if (!valide)
+    {
+        std::cout << "Erreur : l'instantané est invalide ou d'une version non supportée : " << chemin << std::endl;
+        munmap(const_cast<unsigned char*>(donnees_), taille_);
+        donnees_ = nullptr;
+    }
+}
+
+/**
+ * @brief Destructeur : libère la projection en mémoire
+ */
+Instantane::~Instantane()
+{
+    if (donnees_ != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(donnees_), taille_);
+    }
+}
+
+/**
+ * @brief Getter du nom d'une grille
+ * @param grille Indice de la grille
+ * @return Nom de la grille
+ */
+std::string Instantane::getNom(int grille) const
+{
+    const char* nom = reinterpret_cast<const char*>(donnees_ + getEntete().decalageNoms + grille * TAILLE_NOM_GRILLE);
+    return std::string(nom, strnlen(nom, TAILLE_NOM_GRILLE));
+}
+
+/**
+ * @brief Recherche une grille par son nom
+ * @param nom Nom de la grille
+ * @return Indice de la grille, ou -1 si aucune grille ne porte ce nom
+ */
+int Instantane::trouverGrille(const std::string& nom) const
+{
+    for (std::uint32_t k = 0; k < getEntete().nbGrilles; k++)
+    {
+        if (getNom(k) == nom)
+        {
+            return k;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Accède à une tranche de temps d'une grille directement dans le fichier projeté
+ * @param grille Indice de la grille
+ * @param i Indice de la tranche de temps
+ * @return Pointeur vers les nbActif valeurs de la tranche
+ */
+const double* Instantane::tranche(int grille, int i) const
+{
+    const EnteteInstantane& entete = getEntete();
+    return reinterpret_cast<const double*>(donnees_ + entete.decalageGrilles + grille * entete.tailleGrille + i * entete.nbActif * sizeof(double));
+}
+
+/**
+ * @brief Interpole linéairement une tranche de temps d'une grille en une valeur de l'actif
+ * @param grille Indice de la grille
+ * @param i Indice de la tranche de temps
+ * @param S Valeur de l'actif
+ * @return Valeur interpolée, ou NaN si S sort de l'axe de l'actif
+ */
+double Instantane::interpoler(int grille, int i, double S) const
+{
+    const double* actif = getActif();
+    int n = getEntete().nbActif;
+    if (n < 2 || S < actif[0] || S > actif[n-1])
+    {
+        return std::nan("");
+    }
+
+    // L'axe de l'actif n'est pas forcément uniforme : on cherche l'intervalle contenant S
+    int j = std::min(static_cast<int>(std::upper_bound(actif, actif + n, S) - actif) - 1, n - 2);
+    const double* C = tranche(grille, i);
+    double a = (S - actif[j]) / (actif[j+1] - actif[j]);
+    return (1 - a) * C[j] + a * C[j+1];
+}
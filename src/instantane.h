@@ -0,0 +1,152 @@
+/**
+ * @file instantane.h
+ * @brief Déclarations du format binaire d'instantané des grilles solution et de la classe Instantane qui le lit par mmap
+ *
+ * Un instantané est composé, dans cet ordre, d'un en-tête de 128 octets, d'une table des noms des grilles (32 octets par grille),
+ * de l'axe des temps, de l'axe de l'actif puis des grilles stockées ligne par ligne (une ligne par temps). Chaque bloc commence
+ * à un décalage multiple de 64 octets, de sorte que les tranches peuvent être lues directement dans le fichier projeté en mémoire
+ */
+
+#ifndef INSTANTANE_H
+#define INSTANTANE_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+
+#include <vector> // Pour std::vector
+#include <string> // Pour std::string
+#include <cstdint> // Pour les entiers de taille fixe
+#include <cstddef> // Pour std::size_t
+
+const std::uint32_t VERSION_INSTANTANE = 1; // Version courante du format d'instantané
+const std::size_t ALIGNEMENT_INSTANTANE = 64; // Alignement en octets de chaque bloc de l'instantané
+const std::size_t TAILLE_NOM_GRILLE = 32; // Taille en octets d'un nom de grille, zéro terminal compris
+
+/**
+ * @brief Schéma numérique ayant produit les grilles d'un instantané
+ */
+enum class Schema : std::uint32_t
+{
+    CrankNicholson = 0,
+    Implicite = 1,
+    NoyauChaleur = 2,
+    Autre = 3
+};
+
+/**
+ * @brief En-tête d'un instantané, écrit tel quel au début du fichier
+ */
+struct EnteteInstantane
+{
+    char magie[8]; // Signature du format, "BSGRILLE"
+    std::uint32_t version; // Version du format
+    std::uint32_t schema; // Schéma numérique (valeur de Schema)
+    std::uint32_t typeOption; // 0 pour un put, 1 pour un call, 2 pour une autre option
+    std::uint32_t nbGrilles; // Nombre de grilles (prix, grecques, ...)
+    std::uint64_t nbTemps; // Nombre de valeurs de l'axe des temps (lignes de chaque grille)
+    std::uint64_t nbActif; // Nombre de valeurs de l'axe de l'actif (colonnes de chaque grille)
+    double K, T, L, r, sigma; // Paramètres de l'option
+    std::uint64_t decalageNoms; // Décalage en octets de la table des noms
+    std::uint64_t decalageTemps; // Décalage en octets de l'axe des temps
+    std::uint64_t decalageActif; // Décalage en octets de l'axe de l'actif
+    std::uint64_t decalageGrilles; // Décalage en octets de la première grille
+    std::uint64_t tailleGrille; // Taille en octets d'une grille, multiple de l'alignement
+    char reserve[128 - 8 - 4 * 4 - 2 * 8 - 5 * 8 - 5 * 8]; // Octets réservés pour les versions futures
+};
+
+static_assert(sizeof(EnteteInstantane) == 128, "L'en-tête d'un instantané doit faire 128 octets");
+
+/**
+ * @brief Écrit un instantané des grilles solution dans un fichier
+ * @param chemin Chemin du fichier à écrire
+ * @param option Option dont les grilles sont la solution
+ * @param schema Schéma numérique ayant produit les grilles
+ * @param t Valeurs de temps t des lignes des grilles
+ * @param S Valeurs de l'actif S des colonnes des grilles
+ * @param noms Noms des grilles (au plus 31 caractères)
+ * @param grilles Pointeurs vers les grilles, chacune de taille t.size() x S.size()
+ * @return Vrai si l'écriture s'est bien déroulée
+ */
+bool ecrireInstantane(const std::string& chemin, const Option& option, Schema schema, const std::vector<double>& t, const std::vector<double>& S,
+                      const std::vector<std::string>& noms, const std::vector<const std::vector<std::vector<double>>*>& grilles);
+
+/**
+ * @brief Classe qui donne accès en lecture seule à un instantané projeté en mémoire, sans copie ni analyse des grilles
+ */
+class Instantane
+{
+    private:
+        const unsigned char* donnees_; // Début du fichier projeté en mémoire (nullptr si l'ouverture a échoué)
+        std::size_t taille_; // Taille du fichier en octets
+
+    public:
+        /**
+        * @brief Constructeur de la classe Instantane : projette le fichier en mémoire et vérifie son en-tête
+        * @param chemin Chemin du fichier à lire
+        */
+        Instantane(const std::string& chemin);
+
+        /**
+        * @brief Destructeur : libère la projection en mémoire
+        */
+        ~Instantane();
+
+        Instantane(const Instantane&) = delete;
+        Instantane& operator=(const Instantane&) = delete;
+
+        /**
+        * @brief Indique si l'instantané a été ouvert et validé
+        * @return Vrai si l'instantané est utilisable
+        */
+        bool estValide() const { return donnees_ != nullptr; }
+
+        /**
+        * @brief Getter de l'en-tête de l'instantané
+        * @return Référence vers l'en-tête
+        */
+        const EnteteInstantane& getEntete() const { return *reinterpret_cast<const EnteteInstantane*>(donnees_); }
+
+        /**
+        * @brief Getter de l'axe des temps
+        * @return Pointeur vers les nbTemps valeurs de temps
+        */
+        const double* getTemps() const { return reinterpret_cast<const double*>(donnees_ + getEntete().decalageTemps); }
+
+        /**
+        * @brief Getter de l'axe de l'actif
+        * @return Pointeur vers les nbActif valeurs de l'actif
+        */
+        const double* getActif() const { return reinterpret_cast<const double*>(donnees_ + getEntete().decalageActif); }
+
+        /**
+        * @brief Getter du nom d'une grille
+        * @param grille Indice de la grille
+        * @return Nom de la grille
+        */
+        std::string getNom(int grille) const;
+
+        /**
+        * @brief Recherche une grille par son nom
+        * @param nom Nom de la grille
+        * @return Indice de la grille, ou -1 si aucune grille ne porte ce nom
+        */
+        int trouverGrille(const std::string& nom) const;
+
+        /**
+        * @brief Accède à une tranche de temps d'une grille directement dans le fichier projeté
+        * @param grille Indice de la grille
+        * @param i Indice de la tranche de temps
+        * @return Pointeur vers les nbActif valeurs de la tranche
+        */
+        const double* tranche(int grille, int i) const;
+
+        /**
+        * @brief Interpole linéairement une tranche de temps d'une grille en une valeur de l'actif
+        * @param grille Indice de la grille
+        * @param i Indice de la tranche de temps
+        * @param S Valeur de l'actif
+        * @return Valeur interpolée, ou NaN si S sort de l'axe de l'actif
+        */
+        double interpoler(int grille, int i, double S) const;
+};
+
+#endif // INSTANTANE_H
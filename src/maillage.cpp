@@ -0,0 +1,100 @@
+/**
+ * @file maillage.cpp
+ * @brief Implémentation de la classe Maillage
+ */
+
+#include "maillage.h" // Pour la déclaration de la classe Maillage
+
+#include <cmath> // Pour std::nan
+#include <algorithm> // Pour std::min
+
+/**
+ * @brief Constructeur de la classe Maillage à partir des bornes et du nombre de pas
+ * @param T Maturité, borne supérieure de l'axe des temps
+ * @param M Nombre de pas de temps
+ * @param L Borne supérieure de l'axe de l'actif
+ * @param N Nombre de pas d'espace
+ */
+Maillage::Maillage(double T, int M, double L, int N) : Maillage(T, M, 0, L, N) {}
+
+/**
+ * @brief Constructeur de la classe Maillage sur un domaine de l'actif [Smin, L]
+ * @param T Maturité, borne supérieure de l'axe des temps
+ * @param M Nombre de pas de temps
+ * @param Smin Borne inférieure de l'axe de l'actif
+ * @param L Borne supérieure de l'axe de l'actif
+ * @param N Nombre de pas d'espace
+ */
+Maillage::Maillage(double T, int M, double Smin, double L, int N) : t_(M+1), S_(N+1)
+{
+    for (int i = 0; i <= M; i++)
+    {
+        t_[i] = i * T / M;
+    }
+    for (int j = 0; j <= N; j++)
+    {
+        S_[j] = Smin + j * (L - Smin) / N;
+    }
+
+    // Les payoffs reconnaissent la maturité et les bords du domaine par égalité : M * T / M et Smin + N * (L - Smin) / N
+    // peuvent différer de T et de L d'un ulp, les dernières valeurs sont donc exactement T et L
+    t_[M] = T;
+    S_[N] = L;
+
+    precalculer();
+}
+
+/**
+ * @brief Constructeur de la classe Maillage à partir d'axes uniformes existants, qui sont copiés
+ * @param t Valeurs de temps t, de 0 à T
+ * @param S Valeurs de l'actif S, de 0 à L
+ */
+Maillage::Maillage(const std::vector<double>& t, const std::vector<double>& S) : t_(t), S_(S)
+{
+    precalculer();
+}
+
+/**
+ * @brief Calcule les pas, leurs inverses et les termes en j à partir des axes
+ */
+void Maillage::precalculer()
+{
+    M_ = t_.size() - 1;
+    N_ = S_.size() - 1;
+
+    // Pas et inverses, calculés une seule fois pour tous les solveurs partageant le maillage
+    dt_ = (t_[M_] - t_[0]) / M_;
+    dS_ = (S_[N_] - S_[0]) / N_;
+    invDt_ = 1.0 / dt_;
+    invDS_ = 1.0 / dS_;
+    invDS2_ = invDS_ * invDS_;
+
+    // Termes en j des schémas : avec S_j = S_0 + j * dS, S / dS = S_0 / dS + j, qui vaut exactement j sur un domaine partant de 0
+    j_.resize(N_+1);
+    j2_.resize(N_+1);
+    double decalage = S_[0] * invDS_;
+    for (int j = 0; j <= N_; j++)
+    {
+        j_[j] = decalage + j;
+        j2_[j] = j_[j] * j_[j];
+    }
+}
+
+/**
+ * @brief Interpole linéairement une tranche de la solution en une valeur de l'actif
+ * @param C Tranche de la solution sur l'axe de l'actif
+ * @param S Valeur de l'actif
+ * @return Valeur interpolée, ou NaN si S sort du domaine
+ */
+double Maillage::interpoler(const std::vector<double>& C, double S) const
+{
+    if (S < S_.front() || S > S_.back())
+    {
+        return std::nan("");
+    }
+
+    double u = (S - S_.front()) * invDS_;
+    int j = std::min(static_cast<int>(u), N_ - 1);
+    double a = u - j;
+    return (1 - a) * C[j] + a * C[j+1];
+}
@@ -0,0 +1,139 @@
+/**
+ * @file maillage.h
+ * @brief Déclaration de la classe Maillage, grille uniforme en temps et en espace partagée par les solveurs
+ */
+
+#ifndef MAILLAGE_H
+#define MAILLAGE_H
+
+#include <vector> // Pour std::vector
+
+/**
+ * @brief Classe immuable représentant une grille uniforme (t_i, S_j), avec les pas, leurs inverses et les termes en j des schémas précalculés
+ *
+ * Une fois construit, un maillage n'est plus jamais modifié : il peut être partagé par std::shared_ptr<const Maillage> entre
+ * autant de solveurs et de threads que nécessaire, sans synchronisation
+ */
+class Maillage
+{
+    private:
+        std::vector<double> t_; // Valeurs de temps t_i = i * dt
+        std::vector<double> S_; // Valeurs de l'actif S_j = S_0 + j * dS
+        int M_; // Nombre de pas de temps
+        int N_; // Nombre de pas d'espace
+        double dt_; // Pas de temps
+        double dS_; // Pas d'espace
+        double invDt_; // Inverse du pas de temps
+        double invDS_; // Inverse du pas d'espace
+        double invDS2_; // Inverse du carré du pas d'espace
+        std::vector<double> j_; // Termes S_j / dS (égaux à j lorsque S_0 = 0)
+        std::vector<double> j2_; // Termes S_j^2 / dS^2 (égaux à j^2 lorsque S_0 = 0)
+
+        /**
+         * @brief Calcule les pas, leurs inverses et les termes en j à partir des axes
+         */
+        void precalculer();
+
+    public:
+        /**
+         * @brief Constructeur de la classe Maillage à partir des bornes et du nombre de pas
+         * @param T Maturité, borne supérieure de l'axe des temps
+         * @param M Nombre de pas de temps
+         * @param L Borne supérieure de l'axe de l'actif
+         * @param N Nombre de pas d'espace
+         */
+        Maillage(double T, int M, double L, int N);
+
+        /**
+         * @brief Constructeur de la classe Maillage sur un domaine de l'actif [Smin, L], par exemple limité par une barrière basse
+         * @param T Maturité, borne supérieure de l'axe des temps
+         * @param M Nombre de pas de temps
+         * @param Smin Borne inférieure de l'axe de l'actif
+         * @param L Borne supérieure de l'axe de l'actif
+         * @param N Nombre de pas d'espace
+         */
+        Maillage(double T, int M, double Smin, double L, int N);
+
+        /**
+         * @brief Constructeur de la classe Maillage à partir d'axes uniformes existants, qui sont copiés
+         * @param t Valeurs de temps t, de 0 à T
+         * @param S Valeurs de l'actif S, de Smin (0 en général) à L
+         */
+        Maillage(const std::vector<double>& t, const std::vector<double>& S);
+
+        /**
+        * @brief Getter de l'axe des temps
+        * @return Référence constante vers les valeurs de temps t
+        */
+        const std::vector<double>& getTemps() const { return t_; }
+
+        /**
+        * @brief Getter de l'axe de l'actif
+        * @return Référence constante vers les valeurs de l'actif S
+        */
+        const std::vector<double>& getActif() const { return S_; }
+
+        /**
+        * @brief Getter du nombre de pas de temps
+        * @return Nombre de pas de temps
+        */
+        int getM() const { return M_; }
+
+        /**
+        * @brief Getter du nombre de pas d'espace
+        * @return Nombre de pas d'espace
+        */
+        int getN() const { return N_; }
+
+        /**
+        * @brief Getter du pas de temps
+        * @return Pas de temps
+        */
+        double getDt() const { return dt_; }
+
+        /**
+        * @brief Getter du pas d'espace
+        * @return Pas d'espace
+        */
+        double getDS() const { return dS_; }
+
+        /**
+        * @brief Getter de l'inverse du pas de temps
+        * @return Inverse du pas de temps
+        */
+        double getInvDt() const { return invDt_; }
+
+        /**
+        * @brief Getter de l'inverse du pas d'espace
+        * @return Inverse du pas d'espace
+        */
+        double getInvDS() const { return invDS_; }
+
+        /**
+        * @brief Getter de l'inverse du carré du pas d'espace
+        * @return Inverse du carré du pas d'espace
+        */
+        double getInvDS2() const { return invDS2_; }
+
+        /**
+        * @brief Getter des indices d'espace, termes S / dS des schémas
+        * @return Référence constante vers les valeurs j
+        */
+        const std::vector<double>& getIndices() const { return j_; }
+
+        /**
+        * @brief Getter des carrés des indices d'espace, termes S^2 / dS^2 des schémas
+        * @return Référence constante vers les valeurs j^2
+        */
+        const std::vector<double>& getIndicesCarres() const { return j2_; }
+
+        /**
+        * @brief Interpole linéairement une tranche de la solution en une valeur de l'actif
+        * @param C Tranche de la solution sur l'axe de l'actif
+        * @param S Valeur de l'actif
+        * @return Valeur interpolée, ou NaN si S sort du domaine
+        */
+        double interpoler(const std::vector<double>& C, double S) const;
+};
+
+#endif // MAILLAGE_H
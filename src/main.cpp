@@ -8,6 +8,18 @@
 
 #include "diff_finies.h" // Pour les déclarations de la classe DifferencesFinies
 #include "sdl.h" // Pour les déclarations de la classe Sdl
+#include "file_spsc.h" // Pour la file transmettant les tranches calculées au thread d'affichage
+#include "convergence.h" // Pour l'étude de convergence
+#include "serveur.h" // Pour le serveur de prix
+#include "scenarios.h" // Pour la revalorisation sous une matrice de chocs
+#include "tarification.h" // Pour la tarification sur une grille dimensionnée automatiquement
+#include "trace.h" // Pour la trace Chrome des résolutions
+#include "instantane.h" // Pour l'écriture et la lecture des instantanés de grilles
+
+#include <thread> // Pour std::thread
+#include <atomic> // Pour std::atomic
+#include <cstdlib> // Pour std::atof et std::getenv
+#include <cstdio> // Pour std::printf
 
 const int SCREEN_WIDTH = 640; // Nombre de pixel sur la largeur de l'écran
 const int SCREEN_HEIGHT = 480; // Nombre de pixel sur la hauteur de l'écran
@@ -16,6 +28,15 @@ const std::vector<Uint8> red = {255, 0, 0}; // Vecteur de trois entiers non sign
 const std::vector<Uint8> green = {0, 255, 0}; // Vecteur de trois entiers non signés de 8 bits représentant la couleur verte
 const std::vector<Uint8> blue = {0, 0, 255}; // Vecteur de trois entiers non signés de 8 bits représentant la couleur bleu
 
+/**
+ * @brief Structure représentant une tranche de temps calculée, transmise du thread de calcul au thread d'affichage
+ */
+struct Tranche
+{
+    int indice; // Indice i de la tranche de temps
+    std::vector<double> valeurs; // Valeurs C[i] de la tranche
+};
+
 /**
  * @brief Fonction main du programme
  *
@@ -23,10 +44,30 @@ const std::vector<Uint8> blue = {0, 0, 255}; // Vecteur de trois entiers non sig
  * Elle crée également des instances des classes EDP Complete, EDP Réduite, Put et Call, et appelle les méthodes de résolution de l'EDP Complete et de l'EDP Réduite 
  * Enfin, elle affiche les solutions obtenues
  *
+ * Avec l'option --convergence [tolérance], elle mène à la place une étude de convergence des deux schémas pour le put et le call
+ * et recommande la grille la moins coûteuse atteignant la tolérance
+ *
+ * Avec l'option --scenarios, elle affiche la revalorisation du put et du call à la monnaie sous une matrice de chocs spot x volatilité x taux
+ *
+ * Avec l'option --prix <spot> [tolérance], elle tarifie le put et le call en un spot sur une grille dimensionnée pour la tolérance
+ *
+ * Avec l'option --instantane <fichier>, elle écrit les grilles du put et du call dans un instantané binaire, et avec l'option
+ * --lecture <fichier> <spot>, elle tarifie en un spot chaque grille d'un instantané existant, lu par projection en mémoire
+ *
+ * Avec l'option --serveur [socket], elle reste résidente et sert des requêtes de prix sur l'entrée standard ou sur une socket Unix
+ *
+ * Si la variable d'environnement TRACE_CHROME contient un chemin, les phases des résolutions de chaque thread y sont écrites au
+ * format Chrome trace-event à la fin de l'exécution
+ *
+ * @param argc Nombre d'arguments de la ligne de commande
+ * @param argv Arguments de la ligne de commande
  * @return 0 si l'exécution s'est bien déroulée, autre chose sinon
  */
-int main()
+int main(int argc, char* argv[])
 {    
+    // La trace n'est active que si elle est demandée : sinon chaque zone ne coûte qu'une lecture atomique
+    SessionTrace session(std::getenv("TRACE_CHROME"));
+
     /********** Définition des paramètres **********/
 
     // Définition des paramètres de l'EDP de Black Scholes
@@ -35,8 +76,8 @@ int main()
     const double sigma = 0.1;
     const double K = 100;
     const double L = 300;
-    const double M = 1000;
-    const double N = 1000;
+    const int M = 200; // Les schémas implicites sont stables quel que soit dt : peu de pas de temps suffisent
+    const int N = 1000;
     const double dt = T / M;
     const double dS = L / N;
 
@@ -46,6 +87,7 @@ int main()
     {
         t[i] = i * dt;
     }
+    t[M] = T; // Le payoff reconnaît la maturité par égalité
 
     // Définition des valeurs de l'actif S pour lesquelles on calcule la solution
     std::vector<double> S(N+1);
@@ -54,6 +96,9 @@ int main()
         S[j] = j * dS;
     }
 
+    // Maillage partagé en lecture seule par les deux solveurs
+    std::shared_ptr<const Maillage> maillage = std::make_shared<const Maillage>(t, S);
+
     /********** Instanciation des options put et call **********/
 
     // Création d'une instance de l'option put
@@ -62,54 +107,160 @@ int main()
     // Création d'une instance de l'option call
     Call option_call(K, T, L, r, sigma);
 
-    /********** Instanciation des équations aux dérivées partielles **********/
-
-    // Création d'une instance de l'EDP Complete pour un put
-    EDPComplete edp_complete_put(option_put);
+    /********** Étude de convergence **********/
 
-    // Création d'une instance de l'EDP Complete pour un call
-    EDPComplete edp_complete_call(option_call);
-    
-    // Création d'une instance de l'EDP Réduite pour un put
-    EDPReduite edp_reduite_put(option_put);
+    if (argc > 1 && std::string(argv[1]) == "--convergence")
+    {
+        double tolerance = argc > 2 ? std::atof(argv[2]) : 1e-2;
+        int nb_threads = std::max(1u, std::thread::hardware_concurrency());
+        afficherConvergence("Put - Crank Nicholson (EDP complète)", etudeConvergence(option_put, true, 7, nb_threads), tolerance);
+        afficherConvergence("Put - Implicite (EDP réduite)", etudeConvergence(option_put, false, 7, nb_threads), tolerance);
+        afficherConvergence("Call - Crank Nicholson (EDP complète)", etudeConvergence(option_call, true, 7, nb_threads), tolerance);
+        afficherConvergence("Call - Implicite (EDP réduite)", etudeConvergence(option_call, false, 7, nb_threads), tolerance);
+        return 0;
+    }
 
-    // Création d'une instance de l'EDP Réduite pour un call
-    EDPReduite edp_reduite_call(option_call);
+    /********** Matrice de scénarios **********/
 
-    /********** Résolution des équations aux dérivées partielles pour un put **********/
-    
-    // Résolution de l'EDP Complete avec la méthode de Crank Nicholson pour un put
-    CrankNicholson solver_complete_put(edp_complete_put, S, t);
-    std::vector<std::vector<double>> solution_complete_put = solver_complete_put.solve();
+    if (argc > 1 && std::string(argv[1]) == "--scenarios")
+    {
+        std::vector<double> chocs_spot = {-0.2, -0.1, -0.05, 0, 0.05, 0.1, 0.2};
+        std::vector<double> chocs_vol = {-0.05, -0.02, 0, 0.02, 0.05, 0.1};
+        std::vector<double> chocs_taux = {-0.01, 0, 0.01};
+        int nb_threads = std::max(1u, std::thread::hardware_concurrency());
+        afficherScenarios("Put", revaloriserScenarios(option_put, K, chocs_spot, chocs_vol, chocs_taux, M, N, nb_threads), 7, 6, 3);
+        afficherScenarios("Call", revaloriserScenarios(option_call, K, chocs_spot, chocs_vol, chocs_taux, M, N, nb_threads), 7, 6, 3);
+        return 0;
+    }
 
-    // Résolution de l'EDP Réduite avec la méthode Implicite pour un put
-    Implicite solver_reduite_put(edp_reduite_put, S, t);
-    std::vector<std::vector<double>> solution_reduite_put = solver_reduite_put.solve();
+    /********** Tarification en un spot **********/
 
-    // Calcul de l'erreur entre l'EDP Complete et l'EDP Réduite pour un put pour C(0,.)
-    std::vector<double> error_put(solution_complete_put[0].size());
-    for (size_t j = 0; j < solution_complete_put[0].size(); j++)
+    if (argc > 2 && std::string(argv[1]) == "--prix")
     {
-        error_put[j] = solution_complete_put[0][j] - solution_reduite_put[0][j];
+        double spot = std::atof(argv[2]);
+        double tolerance = argc > 3 ? std::atof(argv[3]) : 1e-3;
+        PrixSpot prix_put = prixAutomatique(option_put, spot, tolerance);
+        PrixSpot prix_call = prixAutomatique(option_call, spot, tolerance);
+        std::printf("Put  : %.6f (analytique %.6f), L = %g, M = %d, N = %d\n", prix_put.prix, option_put.prixAnalytique(spot, 0),
+                    prix_put.grille.L, prix_put.grille.M, prix_put.grille.N);
+        std::printf("Call : %.6f (analytique %.6f), L = %g, M = %d, N = %d\n", prix_call.prix, option_call.prixAnalytique(spot, 0),
+                    prix_call.grille.L, prix_call.grille.M, prix_call.grille.N);
+        return 0;
     }
 
-    /********** Résolution des équations aux dérivées partielles pour un call **********/
+    /********** Instantanés **********/
+
+    if (argc > 2 && std::string(argv[1]) == "--instantane")
+    {
+        EDPComplete edp(option_put);
+        std::vector<std::vector<std::vector<double>>> grilles;
+        CrankNicholson(edp, maillage).solve({&option_put, &option_call}, grilles);
+        if (!ecrireInstantane(argv[2], option_put, Schema::CrankNicholson, t, S, {"put", "call"}, {&grilles[0], &grilles[1]}))
+        {
+            return -1;
+        }
+        std::printf("Instantané écrit : %s (%d x %d noeuds par grille)\n", argv[2], M+1, N+1);
+        return 0;
+    }
 
-    // Résolution de l'EDP Complete avec la méthode de Crank Nicholson pour un call
-    CrankNicholson solver_complete_call(edp_complete_call, S, t);
-    std::vector<std::vector<double>> solution_complete_call = solver_complete_call.solve();
+    if (argc > 3 && std::string(argv[1]) == "--lecture")
+    {
+        Instantane instantane(argv[2]);
+        if (!instantane.estValide())
+        {
+            return -1;
+        }
+        double spot = std::atof(argv[3]);
+        for (std::uint32_t k = 0; k < instantane.getEntete().nbGrilles; k++)
+        {
+            std::printf("%s : %.6f\n", instantane.getNom(k).c_str(), instantane.interpoler(k, 0, spot));
+        }
+        return 0;
+    }
 
-    // Résolution de l'EDP Réduite avec la méthode Implicite pour un call
-    Implicite solver_reduite_call(edp_reduite_call, S, t);
-    std::vector<std::vector<double>> solution_reduite_call = solver_reduite_call.solve();
+    /********** Serveur de prix **********/
 
-    // Calcul de l'erreur entre l'EDP Complete et l'EDP Réduite pour un call pour C(0,.)
-    std::vector<double> error_call(solution_complete_call[0].size());
-    for (size_t j = 0; j < solution_complete_call[0].size(); j++)
+    if (argc > 1 && std::string(argv[1]) == "--serveur")
     {
-        error_call[j] = solution_complete_call[0][j] - solution_reduite_call[0][j];
+        ServeurPrix serveur(M, N, 256);
+        if (argc > 2)
+        {
+            return serveur.servirSocket(argv[2]) ? 0 : -1;
+        }
+        serveur.servirEntreeStandard();
+        return 0;
     }
 
+    /********** Instanciation des équations aux dérivées partielles **********/
+
+    // Le put et le call ont le même r, le même sigma et le même maillage : chaque EDP est résolue pour les deux options à la
+    // fois, sur la même factorisation. L'EDP est construite sur le put, dont les tranches sont transmises à l'observateur
+
+    // Création d'une instance de l'EDP Complete
+    EDPComplete edp_complete(option_put);
+
+    // Création d'une instance de l'EDP Réduite
+    EDPReduite edp_reduite(option_put);
+
+    // Options résolues ensemble
+    std::vector<const Option*> options = {&option_put, &option_call};
+
+    /********** Résolution des équations aux dérivées partielles sur un thread de calcul **********/
+
+    // Les tranches de la surface du put sont transmises au fil de l'eau au thread d'affichage
+    FileSPSC<Tranche> file_tranches(1024);
+    std::atomic<bool> calcul_termine(false);
+    std::atomic<bool> abandon(false);
+
+    // Solutions et erreurs, écrites par le thread de calcul et lues une fois le calcul terminé
+    std::vector<std::vector<double>> solution_complete_put;
+    std::vector<std::vector<double>> solution_reduite_put;
+    std::vector<std::vector<double>> solution_complete_call;
+    std::vector<std::vector<double>> solution_reduite_call;
+    std::vector<double> error_put;
+    std::vector<double> error_call;
+
+    std::thread calcul([&]()
+    {
+        /********** Résolution des équations aux dérivées partielles pour le put et le call **********/
+
+        // Résolution de l'EDP Complete avec la méthode de Crank Nicholson
+        std::vector<std::vector<std::vector<double>>> solutions;
+        CrankNicholson solver_complete(edp_complete, maillage);
+        solver_complete.setObservateur([&](int i, const std::vector<double>& tranche)
+        {
+            while (!file_tranches.push({i, tranche}) && !abandon)
+            {
+                std::this_thread::yield();
+            }
+        });
+        solver_complete.solve(options, solutions);
+        solution_complete_put = std::move(solutions[0]);
+        solution_complete_call = std::move(solutions[1]);
+
+        // Résolution de l'EDP Réduite avec la méthode Implicite
+        Implicite solver_reduite(edp_reduite, maillage);
+        solver_reduite.solve(options, solutions);
+        solution_reduite_put = std::move(solutions[0]);
+        solution_reduite_call = std::move(solutions[1]);
+
+        // Calcul de l'erreur entre l'EDP Complete et l'EDP Réduite pour un put pour C(0,.)
+        error_put.resize(solution_complete_put[0].size());
+        for (size_t j = 0; j < solution_complete_put[0].size(); j++)
+        {
+            error_put[j] = solution_complete_put[0][j] - solution_reduite_put[0][j];
+        }
+
+        // Calcul de l'erreur entre l'EDP Complete et l'EDP Réduite pour un call pour C(0,.)
+        error_call.resize(solution_complete_call[0].size());
+        for (size_t j = 0; j < solution_complete_call[0].size(); j++)
+        {
+            error_call[j] = solution_complete_call[0][j] - solution_reduite_call[0][j];
+        }
+
+        calcul_termine.store(true, std::memory_order_release);
+    });
+
     /********** Affichage des solutions et des erreurs matriciellement **********/
     /*
     // Affichage de la solution de l'EDP Complete pour un put
@@ -183,6 +334,8 @@ int main()
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
     {
         std::cerr << "Erreur lors de l'initialisation de SDL : " << SDL_GetError() << std::endl;
+        abandon = true;
+        calcul.join();
         return -1;
     }
 
@@ -210,6 +363,10 @@ int main()
     // Création du renderer pour l'affichage du error_call
     SDL_Renderer* renderer_error_call = init_renderer(window_error_call);
 
+    // Création de la fenêtre et du renderer pour l'affichage de la surface C(t, S) d'un put
+    SDL_Window* window_surface_put = init_window("Surface C(t, S) de l'EDP de Black Scholes pour un Put", SCREEN_WIDTH, SCREEN_HEIGHT);
+    SDL_Renderer* renderer_surface_put = init_renderer(window_surface_put);
+
     // Création d'une instance de la classe Sdl pour l'affichage du put
     Sdl sdl_put(renderer_put, window_put);
 
@@ -222,81 +379,120 @@ int main()
     // Création d'une instance de la classe Sdl pour l'erreur entre l'EDP Complete et l'EDP Réduite pour un call
     Sdl sdl_error_call(renderer_error_call, window_error_call);
 
-    // Déclaration des paramètres pour la gestion de la fermeture des fenêtres
-    bool quit_put = false;
-    bool quit_error_put = false;
-    bool quit_call = false;
-    bool quit_error_call = false;
-    SDL_Event event;
+    // Création d'une instance de la classe Sdl pour l'affichage de la surface complète d'un put
+    Sdl sdl_surface_put(renderer_surface_put, window_surface_put);
+
+    // La surface du put est remplie au fur et à mesure que les tranches sont calculées
+    sdl_surface_put.init_heatmap(t.size(), S.size());
 
-    // Gestion de la fermeture des fenêtres
-    while (!(quit_put && quit_error_put && quit_call && quit_error_call))
+    // Affichage initial des fenêtres
+    std::vector<Sdl*> fenetres = {&sdl_put, &sdl_error_put, &sdl_call, &sdl_error_call, &sdl_surface_put};
+    for (Sdl* fenetre : fenetres)
     {
-        // Récupération des événements SDL
-        while (SDL_PollEvent(&event))
+        fenetre->show();
+    }
+
+    // Gestion des événements : on attend sans consommer de CPU et on ne redessine que si nécessaire
+    int nb_fenetres_ouvertes = fenetres.size();
+    int nb_tranches_recues = 0;
+    bool resultats_affiches = false;
+    SDL_Event event;
+    while (nb_fenetres_ouvertes > 0)
+    {
+        // Tant que le calcul tourne, on se réveille régulièrement pour afficher les nouvelles tranches
+        int evenement_recu = resultats_affiches ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, 30);
+
+        // Toutes les tranches publiées avant la fin du calcul sont dans la file lorsque calcul_termine est lu à vrai
+        bool termine = calcul_termine.load(std::memory_order_acquire);
+
+        // Affichage de la progression et de la surface partielle
+        Tranche tranche;
+        bool nouvelles_tranches = false;
+        while (file_tranches.pop(tranche))
+        {
+            sdl_surface_put.update_heatmap_row(tranche.indice, tranche.valeurs);
+            nb_tranches_recues++;
+            nouvelles_tranches = true;
+        }
+        if (nouvelles_tranches)
         {
-            // Si l'utilisateur souhaite fermer une fenêtre c'est à dire s'il a cliqué sur X
-            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE)
+            sdl_surface_put.set_title("Surface C(t, S) de l'EDP de Black Scholes pour un Put (" + std::to_string(nb_tranches_recues) + "/" + std::to_string(t.size()) + ")");
+            sdl_surface_put.show();
+        }
+
+        // Une fois le calcul terminé, les courbes sont transmises une seule fois : chaque fenêtre les garde en cache
+        if (termine && !resultats_affiches)
+        {
+            calcul.join();
+            sdl_put.add_curve(S, solution_complete_put[0], green);
+            sdl_put.add_curve(S, solution_reduite_put[0], blue);
+            sdl_error_put.add_curve(S, error_put, red);
+            sdl_call.add_curve(S, solution_complete_call[0], green);
+            sdl_call.add_curve(S, solution_reduite_call[0], blue);
+            sdl_error_call.add_curve(S, error_call, red);
+            for (Sdl* fenetre : fenetres)
             {
-                // Si l'utilisateur souhaite fermer la fenêtre des solutions pour un put
-                if (SDL_GetWindowID(window_put) == event.window.windowID)
-                {
-                    cleanup(renderer_put, window_put); // Nettoyage de la fenêtre
-                    quit_put = true;
-                }
-
-                // Si l'utilisateur souhaite fermer la fenêtre des erreurs pour un put
-                if (SDL_GetWindowID(window_error_put) == event.window.windowID)
-                {
-                    cleanup(renderer_error_put, window_error_put); // Nettoyage de la fenêtre
-                    quit_error_put = true;
-                }
-
-                // Si l'utilisateur souhaite fermer la fenêtre des solutions pour un call
-                if (SDL_GetWindowID(window_call) == event.window.windowID)
-                {
-                    cleanup(renderer_call, window_call); // Nettoyage de la fenêtre
-                    quit_call = true;
-                }
-
-                // Si l'utilisateur souhaite fermer la fenêtre des erreur pour un call
-                if (SDL_GetWindowID(window_error_call) == event.window.windowID)
-                {
-                    cleanup(renderer_error_call, window_error_call); // Nettoyage de la fenêtre
-                    quit_error_call = true;
-                }
+                fenetre->show();
             }
+            resultats_affiches = true;
         }
 
-        // Affichage de la courbe de la solution de l'EDP Complete pour un put
-        sdl_put.draw_curve(t, solution_complete_put[0], green);
-
-        // Affichage de la courbe de la solution de l'EDP Réduite pour un put
-        sdl_put.draw_curve(t, solution_reduite_put[0], blue);
-
-        // Affichage la fenêtre SDL
-        sdl_put.show();
-
-        // Affichage de la courbe de l'erreur entre l'EDP Complete et l'EDP Réduite pour un put
-        sdl_error_put.draw_curve(t, error_put, red);
+        if (!evenement_recu)
+        {
+            continue;
+        }
 
-        // Affichage la fenêtre SDL
-        sdl_error_put.show();
+        if (event.type == SDL_QUIT)
+        {
+            break;
+        }
 
-        // Affichage de la courbe de la solution de l'EDP Complete pour un call
-        sdl_call.draw_curve(t, solution_complete_call[0], green);
+        if (event.type != SDL_WINDOWEVENT)
+        {
+            continue;
+        }
 
-        // Affichage de la courbe de la solution de l'EDP Réduite pour un call
-        sdl_call.draw_curve(t, solution_reduite_call[0], blue);
+        // Recherche de la fenêtre concernée par l'événement
+        for (Sdl* fenetre : fenetres)
+        {
+            if (fenetre->getWindowID() != event.window.windowID)
+            {
+                continue;
+            }
 
-        // Affichage la fenêtre SDL
-        sdl_call.show();
+            switch (event.window.event)
+            {
+                // Si l'utilisateur a cliqué sur X, on ferme la fenêtre
+                case SDL_WINDOWEVENT_CLOSE:
+                    fenetre->close();
+                    nb_fenetres_ouvertes--;
+                    break;
+
+                // Si la fenêtre a changé de taille, on redessine les courbes à la nouvelle taille
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    fenetre->invalidate();
+                    fenetre->show();
+                    break;
+
+                // Si la fenêtre a été découverte, on recopie simplement la texture cache
+                case SDL_WINDOWEVENT_EXPOSED:
+                    fenetre->show();
+                    break;
+            }
+        }
+    }
 
-        // Affichage de la courbe de l'erreur entre l'EDP Complete et l'EDP Réduite pour un call
-        sdl_error_call.draw_curve(t, error_call, red);
+    // Si l'utilisateur a tout fermé avant la fin du calcul, le thread de calcul ne doit plus attendre la file
+    abandon = true;
+    if (calcul.joinable())
+    {
+        calcul.join();
+    }
 
-        // Afficher la fenêtre SDL
-        sdl_error_call.show();
+    // Fermeture des fenêtres encore ouvertes avant de quitter SDL
+    for (Sdl* fenetre : fenetres)
+    {
+        fenetre->close();
     }
 
     // Fermeture de SDL
@@ -0,0 +1,258 @@
+/**
+ * @file monte_carlo.cpp
+ * @brief Implémentation du générateur Philox et de la classe MonteCarlo
+ */
+
+#include "monte_carlo.h" // Pour la déclaration de la classe MonteCarlo
+
+#include <thread> // Pour std::thread
+#include <cmath> // Pour std::sqrt, std::log et std::exp
+#include <iostream> // Pour std::cout et std::endl
+
+const int TAILLE_PAQUET = 4096; // Nombre de tirages d'un paquet, unité de travail distribuée aux threads
+const int LARGEUR = 8; // Nombre de tirages simulés simultanément dans un paquet
+
+/**
+ * @brief Constructeur de la classe Philox
+ * @param graine Graine du générateur
+ */
+Philox::Philox(std::uint64_t graine) : cle_{static_cast<std::uint32_t>(graine), static_cast<std::uint32_t>(graine >> 32)} {}
+
+/**
+ * @brief Calcule le bloc de quatre entiers aléatoires associé à un compteur
+ * @param compteur Compteur de 128 bits
+ * @return Quatre entiers aléatoires de 32 bits
+ */
+std::array<std::uint32_t, 4> Philox::operator()(std::array<std::uint32_t, 4> compteur) const
+{
+    // Constantes de Philox4x32
+    const std::uint64_t M0 = 0xD2511F53;
+    const std::uint64_t M1 = 0xCD9E8D57;
+    const std::uint32_t W0 = 0x9E3779B9;
+    const std::uint32_t W1 = 0xBB67AE85;
+
+    std::array<std::uint32_t, 2> cle = cle_;
+    std::array<std::uint32_t, 4> c = compteur;
+
+    // Dix tours de multiplication et de mélange
+    for (int tour = 0; tour < 10; tour++)
+    {
+        std::uint64_t p0 = M0 * c[0];
+        std::uint64_t p1 = M1 * c[2];
+        c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ cle[0], static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ cle[1], static_cast<std::uint32_t>(p0)};
+        cle[0] += W0;
+        cle[1] += W1;
+    }
+
+    return c;
+}
+
+/**
+ * @brief Calcule quatre tirages de loi normale centrée réduite par la méthode de Box-Muller
+ * @param chemin Indice du chemin
+ * @param bloc Indice du bloc de quatre pas de temps
+ * @param z Tableau dans lequel on écrit les quatre tirages
+ */
+void Philox::normales(std::uint64_t chemin, std::uint32_t bloc, double z[4]) const
+{
+    std::array<std::uint32_t, 4> u = (*this)({static_cast<std::uint32_t>(chemin), static_cast<std::uint32_t>(chemin >> 32), bloc, 0});
+
+    // Uniformes dans ]0, 1[
+    const double echelle = 1.0 / 4294967296.0;
+    const double pi = std::acos(-1.0);
+    for (int k = 0; k < 4; k += 2)
+    {
+        double u1 = (u[k] + 0.5) * echelle;
+        double u2 = (u[k+1] + 0.5) * echelle;
+        double rayon = std::sqrt(-2 * std::log(u1));
+        z[k] = rayon * std::cos(2 * pi * u2);
+        z[k+1] = rayon * std::sin(2 * pi * u2);
+    }
+}
+
+/**
+ * @brief Constructeur de la classe MonteCarlo
+ * @param option Option à évaluer
+ * @param nbTirages Nombre de tirages indépendants
+ * @param nbPas Nombre de pas de temps par chemin
+ * @param nbThreads Nombre de threads utilisés
+ * @param graine Graine du générateur aléatoire
+ */
+MonteCarlo::MonteCarlo(const Option& option, int nbTirages, int nbPas, int nbThreads, std::uint64_t graine)
+    : option_(option), nbTirages_(nbTirages), nbPas_(nbPas), nbThreads_(nbThreads), philox_(graine), antithetique_(true), variableControle_(false), erreurStandard_(0) {}
+
+/**
+ * @brief Active ou désactive la variable de contrôle
+ * @param variableControle Vrai pour utiliser le payoff européen et son prix analytique comme variable de contrôle
+ * @return Faux si la variable de contrôle est demandée pour une option qui n'est ni un Put ni un Call (elle reste désactivée)
+ */
+bool MonteCarlo::setVariableControle(bool variableControle)
+{
+    // Le prix analytique n'est l'espérance actualisée du payoff à maturité que pour les options vanilles
+    if (variableControle && !dynamic_cast<const Put*>(&option_) && !dynamic_cast<const Call*>(&option_))
+    {
+        std::cout << "Erreur : la variable de contrôle demande un Put ou un Call, dont le prix analytique est l'espérance du payoff" << std::endl;
+        variableControle_ = false;
+        return false;
+    }
+
+    variableControle_ = variableControle;
+    return true;
+}
+
+/**
+ * @brief Méthode qui estime le prix de l'option au temps 0
+ * @param S0 Valeur de l'actif au temps 0
+ * @return Estimation du prix de l'option
+ */
+double MonteCarlo::solve(double S0)
+{
+    // On précalcule la dérive et la diffusion du logarithme de l'actif sur chaque pas de temps
+    double T = option_.getT();
+    double dt = T / nbPas_;
+    std::vector<double> derive(nbPas_);
+    std::vector<double> diffusion(nbPas_);
+    for (int k = 0; k < nbPas_; k++)
+    {
+        double r = option_.getR(k * dt);
+        double sigma = option_.getSigma(k * dt);
+        derive[k] = (r - sigma * sigma / 2) * dt;
+        diffusion[k] = sigma * std::sqrt(dt);
+    }
+    double actualisation = option_.facteurActualisation(0);
+
+    // Sommes partielles de chaque paquet : X, Y, X^2, Y^2 et XY (X est le payoff évalué, Y la variable de contrôle)
+    int nbPaquets = (nbTirages_ + TAILLE_PAQUET - 1) / TAILLE_PAQUET;
+    std::vector<std::array<double, 5>> sommes(nbPaquets);
+
+    // Simulation d'un paquet de tirages
+    auto simulerPaquet = [&](int paquet)
+    {
+        std::array<double, 5> somme = {0, 0, 0, 0, 0};
+        int nbSens = antithetique_ ? 2 : 1;
+
+        // Tirages normaux du bloc, rangés pas par pas pour que la mise à jour des chemins soit vectorisable
+        std::vector<double> z(((nbPas_ + 3) / 4) * 4 * LARGEUR);
+        std::vector<std::vector<double>> chemins(payoffChemin_ ? LARGEUR : 0, std::vector<double>(nbPas_ + 1));
+
+        int debut = paquet * TAILLE_PAQUET;
+        int fin = std::min(debut + TAILLE_PAQUET, nbTirages_);
+        for (int base = debut; base < fin; base += LARGEUR)
+        {
+            int largeur = std::min(LARGEUR, fin - base);
+
+            for (int b = 0; b < largeur; b++)
+            {
+                for (int bloc = 0; 4 * bloc < nbPas_; bloc++)
+                {
+                    double tirage[4];
+                    philox_.normales(base + b, bloc, tirage);
+                    for (int k = 0; k < 4; k++)
+                    {
+                        z[(4 * bloc + k) * LARGEUR + b] = tirage[k];
+                    }
+                }
+            }
+
+            double X[LARGEUR] = {};
+            double Y[LARGEUR] = {};
+            for (int sens = 0; sens < nbSens; sens++)
+            {
+                double signe = (sens == 0) ? 1.0 : -1.0;
+
+                // On fait évoluer les LARGEUR chemins simultanément
+                double logS[LARGEUR];
+                for (int b = 0; b < LARGEUR; b++)
+                {
+                    logS[b] = std::log(S0);
+                }
+                for (int k = 0; k < nbPas_; k++)
+                {
+                    const double* zk = &z[k * LARGEUR];
+                    for (int b = 0; b < LARGEUR; b++)
+                    {
+                        logS[b] += derive[k] + signe * diffusion[k] * zk[b];
+                    }
+                    for (std::size_t b = 0; b < chemins.size(); b++)
+                    {
+                        chemins[b][k+1] = std::exp(logS[b]);
+                    }
+                }
+
+                // Payoffs actualisés de chaque chemin
+                for (int b = 0; b < largeur; b++)
+                {
+                    double payoffEuropeen = actualisation * option_.payoff(std::exp(logS[b]), T);
+                    if (payoffChemin_)
+                    {
+                        chemins[b][0] = S0;
+                        X[b] += actualisation * payoffChemin_(chemins[b]) / nbSens;
+                    }
+                    else
+                    {
+                        X[b] += payoffEuropeen / nbSens;
+                    }
+                    Y[b] += payoffEuropeen / nbSens;
+                }
+            }
+
+            for (int b = 0; b < largeur; b++)
+            {
+                somme[0] += X[b];
+                somme[1] += Y[b];
+                somme[2] += X[b] * X[b];
+                somme[3] += Y[b] * Y[b];
+                somme[4] += X[b] * Y[b];
+            }
+        }
+
+        sommes[paquet] = somme;
+    };
+
+    // Les paquets sont répartis entre les threads de façon cyclique
+    std::vector<std::thread> threads;
+    for (int id = 0; id < nbThreads_; id++)
+    {
+        threads.emplace_back([&, id]()
+        {
+            for (int paquet = id; paquet < nbPaquets; paquet += nbThreads_)
+            {
+                simulerPaquet(paquet);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // On réduit les sommes dans l'ordre des paquets, pour un résultat indépendant du nombre de threads
+    std::array<double, 5> total = {0, 0, 0, 0, 0};
+    for (const auto& somme : sommes)
+    {
+        for (int k = 0; k < 5; k++)
+        {
+            total[k] += somme[k];
+        }
+    }
+
+    double n = nbTirages_;
+    double moyenneX = total[0] / n;
+    double moyenneY = total[1] / n;
+    double varianceX = (total[2] - n * moyenneX * moyenneX) / (n - 1);
+    double varianceY = (total[3] - n * moyenneY * moyenneY) / (n - 1);
+    double covariance = (total[4] - n * moyenneX * moyenneY) / (n - 1);
+
+    // Sans variable de contrôle, on retourne la moyenne empirique
+    if (!variableControle_ || varianceY <= 0)
+    {
+        erreurStandard_ = std::sqrt(std::max(0.0, varianceX) / n);
+        return moyenneX;
+    }
+
+    // Avec variable de contrôle, on corrige par l'écart entre la moyenne de Y et son prix analytique
+    double beta = covariance / varianceY;
+    erreurStandard_ = std::sqrt(std::max(0.0, varianceX - covariance * covariance / varianceY) / n);
+    return moyenneX - beta * (moyenneY - option_.prixAnalytique(S0, 0));
+}
@@ -0,0 +1,115 @@
+/**
+ * @file monte_carlo.h
+ * @brief Déclarations du générateur Philox et de la classe MonteCarlo
+ */
+
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+
+#include <vector> // Pour std::vector
+#include <array> // Pour std::array
+#include <cstdint> // Pour std::uint32_t et std::uint64_t
+#include <functional> // Pour std::function
+
+/**
+ * @brief Générateur aléatoire à compteur Philox4x32-10
+ *
+ * Le tirage ne dépend que du compteur et de la clé : chaque chemin possède son propre flux, ce qui rend les résultats
+ * reproductibles quel que soit le nombre de threads
+ */
+class Philox
+{
+    private:
+        std::array<std::uint32_t, 2> cle_; // Clé du générateur, dérivée de la graine
+
+    public:
+        /**
+        * @brief Constructeur de la classe Philox
+        * @param graine Graine du générateur
+        */
+        Philox(std::uint64_t graine);
+
+        /**
+        * @brief Calcule le bloc de quatre entiers aléatoires associé à un compteur
+        * @param compteur Compteur de 128 bits
+        * @return Quatre entiers aléatoires de 32 bits
+        */
+        std::array<std::uint32_t, 4> operator()(std::array<std::uint32_t, 4> compteur) const;
+
+        /**
+        * @brief Calcule quatre tirages de loi normale centrée réduite par la méthode de Box-Muller
+        * @param chemin Indice du chemin
+        * @param bloc Indice du bloc de quatre pas de temps
+        * @param z Tableau dans lequel on écrit les quatre tirages
+        */
+        void normales(std::uint64_t chemin, std::uint32_t bloc, double z[4]) const;
+};
+
+/**
+ * @brief Classe qui évalue une option par la méthode de Monte Carlo, en parallèle sur plusieurs threads
+ */
+class MonteCarlo
+{
+    private:
+        const Option& option_; // Option à évaluer
+        int nbTirages_; // Nombre de tirages indépendants
+        int nbPas_; // Nombre de pas de temps par chemin
+        int nbThreads_; // Nombre de threads utilisés
+        Philox philox_; // Générateur aléatoire à compteur
+        bool antithetique_; // Vrai pour utiliser des variables antithétiques
+        bool variableControle_; // Vrai pour utiliser le payoff européen et son prix analytique comme variable de contrôle
+        std::function<double(const std::vector<double>&)> payoffChemin_; // Payoff dépendant du chemin (payoff européen si vide)
+        double erreurStandard_; // Erreur standard de la dernière estimation
+
+    public:
+        /**
+        * @brief Constructeur de la classe MonteCarlo
+        * @param option Option à évaluer
+        * @param nbTirages Nombre de tirages indépendants
+        * @param nbPas Nombre de pas de temps par chemin
+        * @param nbThreads Nombre de threads utilisés
+        * @param graine Graine du générateur aléatoire
+        */
+        MonteCarlo(const Option& option, int nbTirages, int nbPas, int nbThreads, std::uint64_t graine);
+
+        /**
+        * @brief Active ou désactive les variables antithétiques
+        * @param antithetique Vrai pour utiliser des variables antithétiques
+        */
+        void setAntithetique(bool antithetique) { antithetique_ = antithetique; }
+
+        /**
+        * @brief Active ou désactive la variable de contrôle
+        *
+        * La variable de contrôle est le payoff européen de l'option, corrigé par son prix analytique : elle n'est sans biais que
+        * si ce prix est l'espérance actualisée du payoff à maturité, c'est-à-dire pour un Put ou un Call. Pour une autre option
+        * (une barrière, dont le prix analytique est celui de l'option désactivante), elle est refusée
+        *
+        * @param variableControle Vrai pour utiliser le payoff européen et son prix analytique comme variable de contrôle
+        * @return Faux si la variable de contrôle est demandée pour une option qui n'est ni un Put ni un Call (elle reste désactivée)
+        */
+        bool setVariableControle(bool variableControle);
+
+        /**
+        * @brief Définit un payoff dépendant du chemin
+        * @param payoffChemin Fonction qui retourne le payoff (non actualisé) à partir des valeurs de l'actif aux nbPas+1 dates du chemin
+        */
+        void setPayoffChemin(std::function<double(const std::vector<double>&)> payoffChemin) { payoffChemin_ = payoffChemin; }
+
+        /**
+        * @brief Getter de l'erreur standard de la dernière estimation
+        * @return Erreur standard de la dernière estimation
+        */
+        double getErreurStandard() const { return erreurStandard_; }
+
+        /**
+        * @brief Méthode qui estime le prix de l'option au temps 0
+        * @param S0 Valeur de l'actif au temps 0
+        * @return Estimation du prix de l'option
+        */
+        double solve(double S0);
+};
+
+#endif // MONTE_CARLO_H
@@ -5,6 +5,8 @@
 
 #include "option.h"  // Pour la déclaration de la classe Option
 
+#include <iostream> // Pour std::cout et std::endl
+
 /**
  * @brief Constructeur de la classe Option
  * @param K Strike de l'option
@@ -15,6 +17,110 @@
  */
 Option::Option(double K, double T, double L, double r, double sigma) : K_(K), T_(T), L_(L), r_(r), sigma_(sigma) {}
 
+/**
+ * @brief Retourne l'indice du segment de la structure par termes contenant le temps t
+ * @param t Valeur du temps t
+ * @return Indice du segment contenant t
+ */
+int Option::segment(double t) const
+{
+    // Les dates sont croissantes : on cherche la première date strictement supérieure à t
+    int k = std::upper_bound(dates_.begin(), dates_.end(), t) - dates_.begin();
+    return std::min(k, static_cast<int>(rCourbe_.size()) - 1);
+}
+
+/**
+ * @brief Définit des structures par termes constantes par morceaux pour le taux et la volatilité
+ * @param dates Dates de fin des segments, croissantes
+ * @param r Taux d'intérêt sur chaque segment
+ * @param sigma Volatilité sur chaque segment
+ */
+void Option::setStructureParTermes(const std::vector<double>& dates, const std::vector<double>& r, const std::vector<double>& sigma)
+{
+    if (dates.size() != r.size() || dates.size() != sigma.size())
+    {
+        std::cout << "Erreur : les structures par termes doivent avoir le même nombre de segments" << std::endl;
+        return;
+    }
+
+    // segment() cherche le temps par dichotomie : des dates dans le désordre choisiraient silencieusement un mauvais segment
+    for (std::size_t k = 0; k < dates.size(); k++)
+    {
+        if (dates[k] <= (k == 0 ? 0 : dates[k-1]) || dates[k] > T_)
+        {
+            std::cout << "Erreur : les dates de la structure par termes doivent être strictement croissantes et comprises dans ]0, T]" << std::endl;
+            return;
+        }
+        if (sigma[k] < 0)
+        {
+            std::cout << "Erreur : les volatilités de la structure par termes doivent être positives" << std::endl;
+            return;
+        }
+    }
+
+    dates_ = dates;
+    rCourbe_ = r;
+    sigmaCourbe_ = sigma;
+}
+
+/**
+ * @brief Calcule le facteur d'actualisation exp(-intégrale de r entre t et T)
+ * @param t Valeur du temps t
+ * @return Facteur d'actualisation entre t et T
+ */
+double Option::facteurActualisation(double t) const
+{
+    if (dates_.empty())
+        return std::exp(-r_ * (T_ - t));
+
+    return std::exp(-integrale(rCourbe_, t, 1));
+}
+
+/**
+ * @brief Calcule la variance totale (intégrale de sigma^2 entre t et T)
+ * @param t Valeur du temps t
+ * @return Variance totale entre t et T
+ */
+double Option::varianceTotale(double t) const
+{
+    if (dates_.empty())
+        return sigma_ * sigma_ * (T_ - t);
+
+    return integrale(sigmaCourbe_, t, 2);
+}
+
+/**
+ * @brief Intègre entre t et T une courbe constante par morceaux élevée à une puissance
+ * @param courbe Valeurs de la courbe sur chaque segment de la structure par termes
+ * @param t Valeur du temps t
+ * @param puissance Puissance à laquelle on élève la courbe (1 pour le taux, 2 pour la variance)
+ * @return Intégrale de la courbe entre t et T
+ */
+double Option::integrale(const std::vector<double>& courbe, double t, int puissance) const
+{
+    // On intègre la courbe segment par segment
+    double somme = 0;
+    double debut = t;
+    for (int k = segment(t); k < static_cast<int>(dates_.size()) && debut < T_; k++)
+    {
+        double fin = (k == static_cast<int>(dates_.size()) - 1) ? T_ : std::min(dates_[k], T_);
+        somme += std::pow(courbe[k], puissance) * (fin - debut);
+        debut = fin;
+    }
+
+    return somme;
+}
+
+/**
+ * @brief Fonction de répartition de la loi normale centrée réduite
+ * @param x Valeur à laquelle on évalue la fonction de répartition
+ * @return Probabilité qu'une variable normale centrée réduite soit inférieure à x
+ */
+double repartitionNormale(double x)
+{
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
 /**
  * @brief Constructeur de la classe Put
  * @param K Strike de l'option
@@ -34,7 +140,7 @@ Put::Put(double K, double T, double L, double r, double sigma) : Option(K, T, L,
 double Put::payoff(double S, double t) const
 {
     if (S == 0)
-        return K_ * std::exp(-r_ * (T_ - t));
+        return K_ * facteurActualisation(t);
     else if (S == L_)
         return 0;
     else if (t == T_)
@@ -43,6 +149,26 @@ double Put::payoff(double S, double t) const
         return 0;
 }
 
+/**
+ * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+ * @param S Valeur de l'actif en temps t
+ * @param t Valeur du temps t
+ * @return Prix analytique de l'option put pour la valeur de l'actif S au temps t
+ */
+double Put::prixAnalytique(double S, double t) const
+{
+    double actualisation = facteurActualisation(t);
+    double variance = varianceTotale(t);
+
+    // À maturité ou sans volatilité, le prix est la valeur intrinsèque actualisée
+    if (variance <= 0 || S <= 0)
+        return std::max(0.0, K_ * actualisation - S);
+
+    double d1 = (std::log(S / (K_ * actualisation)) + variance / 2) / std::sqrt(variance);
+    double d2 = d1 - std::sqrt(variance);
+    return K_ * actualisation * repartitionNormale(-d2) - S * repartitionNormale(-d1);
+}
+
 /**
  * @brief Constructeur de la classe Call
  * @param K Strike de l'option
@@ -64,9 +190,29 @@ double Call::payoff(double S, double t) const
     if (S == 0)
         return 0;
     else if (S == L_)
-        return K_ * std::exp(-r_ * (t - T_));
+        return S - K_ * facteurActualisation(t);
     else if (t == T_)
         return std::max(0.0, S - K_);
     else
         return 0;
 }
+
+/**
+ * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+ * @param S Valeur de l'actif en temps t
+ * @param t Valeur du temps t
+ * @return Prix analytique de l'option call pour la valeur de l'actif S au temps t
+ */
+double Call::prixAnalytique(double S, double t) const
+{
+    double actualisation = facteurActualisation(t);
+    double variance = varianceTotale(t);
+
+    // À maturité ou sans volatilité, le prix est la valeur intrinsèque actualisée
+    if (variance <= 0 || S <= 0)
+        return std::max(0.0, S - K_ * actualisation);
+
+    double d1 = (std::log(S / (K_ * actualisation)) + variance / 2) / std::sqrt(variance);
+    double d2 = d1 - std::sqrt(variance);
+    return S * repartitionNormale(d1) - K_ * actualisation * repartitionNormale(d2);
+}
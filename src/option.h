@@ -8,6 +8,7 @@
 
 #include <algorithm> // Pour std::max
 #include <cmath> // Pour std::exp
+#include <vector> // Pour std::vector
 
 /**
  * @brief Classe abstraite représentant une option
@@ -20,6 +21,25 @@ class Option
         double L_;  // Valeur terminal de l'option
         double r_;  // Taux d'intérêt du marché
         double sigma_;  // Volatilité de l'actif
+        std::vector<double> dates_;  // Dates de fin des segments de la structure par termes (vide si r et sigma sont constants)
+        std::vector<double> rCourbe_;  // Taux d'intérêt sur chaque segment de la structure par termes
+        std::vector<double> sigmaCourbe_;  // Volatilité sur chaque segment de la structure par termes
+
+        /**
+        * @brief Retourne l'indice du segment de la structure par termes contenant le temps t
+        * @param t Valeur du temps t
+        * @return Indice du segment contenant t
+        */
+        int segment(double t) const;
+
+        /**
+        * @brief Intègre entre t et T une courbe constante par morceaux élevée à une puissance
+        * @param courbe Valeurs de la courbe sur chaque segment de la structure par termes
+        * @param t Valeur du temps t
+        * @param puissance Puissance à laquelle on élève la courbe (1 pour le taux, 2 pour la variance)
+        * @return Intégrale de la courbe entre t et T
+        */
+        double integrale(const std::vector<double>& courbe, double t, int puissance) const;
 
     public:
         /**
@@ -62,6 +82,74 @@ class Option
         */
         double getSigma() const { return sigma_; }
 
+        /**
+        * @brief Getter du taux d'intérêt du marché au temps t
+        * @param t Valeur du temps t
+        * @return Valeur du taux d'intérêt du marché sur le segment contenant t
+        */
+        double getR(double t) const { return dates_.empty() ? r_ : rCourbe_[segment(t)]; }
+
+        /**
+        * @brief Getter de la volatilité de l'actif au temps t
+        * @param t Valeur du temps t
+        * @return Valeur de la volatilité de l'actif sur le segment contenant t
+        */
+        double getSigma(double t) const { return dates_.empty() ? sigma_ : sigmaCourbe_[segment(t)]; }
+
+        /**
+        * @brief Définit des structures par termes constantes par morceaux pour le taux et la volatilité
+        *
+        * Le segment k couvre l'intervalle [dates[k-1], dates[k]) avec dates[-1] = 0, le dernier segment s'étendant jusqu'à T.
+        * Des structures invalides sont refusées avec un message d'erreur, l'option gardant alors ses coefficients précédents
+        *
+        * @param dates Dates de fin des segments, strictement croissantes dans ]0, T]
+        * @param r Taux d'intérêt sur chaque segment
+        * @param sigma Volatilité sur chaque segment, positive
+        */
+        void setStructureParTermes(const std::vector<double>& dates, const std::vector<double>& r, const std::vector<double>& sigma);
+
+        /**
+        * @brief Calcule le facteur d'actualisation exp(-intégrale de r entre t et T)
+        * @param t Valeur du temps t
+        * @return Facteur d'actualisation entre t et T
+        */
+        double facteurActualisation(double t) const;
+
+        /**
+        * @brief Calcule la variance totale (intégrale de sigma^2 entre t et T)
+        * @param t Valeur du temps t
+        * @return Variance totale entre t et T
+        */
+        double varianceTotale(double t) const;
+
+        /**
+        * @brief Indique si le taux et la volatilité de l'option sont constants dans le temps
+        * @return Vrai si les coefficients de l'EDP associée sont constants
+        */
+        virtual bool coefficientsConstants() const { return dates_.empty(); }
+
+        /**
+        * @brief Borne inférieure du domaine de l'actif sur lequel l'option est résolue
+        * @return 0, sauf pour une option dont une barrière basse est le bord du domaine
+        */
+        virtual double getBorneInferieure() const { return 0; }
+
+        /**
+        * @brief Indique si l'option a des dates de surveillance auxquelles une tranche calculée doit être modifiée
+        * @return Faux pour une option européenne
+        */
+        virtual bool estSurveilleeDiscretement() const { return false; }
+
+        /**
+        * @brief Applique les conditions des dates de surveillance comprises dans [t, t + dt) à une tranche calculée au temps t
+        * @param t Temps de la tranche
+        * @param dt Pas de temps qui sépare la tranche de la suivante
+        * @param S Valeurs de l'actif de la tranche
+        * @param tranche Valeurs de la tranche, modifiées en place
+        * @return Vrai si la tranche a été modifiée (jamais pour une option européenne)
+        */
+        virtual bool surveiller(double /* t */, double /* dt */, const std::vector<double>& /* S */, std::vector<double>& /* tranche */) const { return false; }
+
         /**
         * @brief Méthode virtuelle pure qui retourne le payoff de l'option pour une valeur donnée de l'actif
         * @param S Valeur de l'actif en temps t
@@ -69,8 +157,23 @@ class Option
         * @return Payoff de l'option put pour la valeur de l'actif S au temps t
         */
         virtual double payoff(double S, double t) const = 0;
+
+        /**
+        * @brief Méthode virtuelle pure qui retourne le prix analytique de Black Scholes de l'option
+        * @param S Valeur de l'actif en temps t
+        * @param t Valeur du temps t
+        * @return Prix analytique de l'option pour la valeur de l'actif S au temps t
+        */
+        virtual double prixAnalytique(double S, double t) const = 0;
 };
 
+/**
+ * @brief Fonction de répartition de la loi normale centrée réduite
+ * @param x Valeur à laquelle on évalue la fonction de répartition
+ * @return Probabilité qu'une variable normale centrée réduite soit inférieure à x
+ */
+double repartitionNormale(double x);
+
 /**
  * @brief Classe concrète représentant une option put
  */
@@ -94,6 +197,14 @@ class Put : public Option
         * @return Payoff de l'option put pour la valeur de l'actif S au temps t
         */
         double payoff(double S, double t) const override;
+
+        /**
+        * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+        * @param S Valeur de l'actif en temps t
+        * @param t Valeur du temps t
+        * @return Prix analytique de l'option put pour la valeur de l'actif S au temps t
+        */
+        double prixAnalytique(double S, double t) const override;
 };
 
 /**
@@ -119,6 +230,14 @@ class Call : public Option
         * @return Payoff de l'option call pour la valeur de l'actif S au temps t
         */
         double payoff(double S, double t) const override;
+
+        /**
+        * @brief Implémentation de la méthode virtuelle pure prixAnalytique
+        * @param S Valeur de l'actif en temps t
+        * @param t Valeur du temps t
+        * @return Prix analytique de l'option call pour la valeur de l'actif S au temps t
+        */
+        double prixAnalytique(double S, double t) const override;
 };
 
 #endif  // OPTION_H
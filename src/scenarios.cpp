@@ -0,0 +1,155 @@
+/**
+ * @file scenarios.cpp
+ * @brief Implémentation du moteur de revalorisation d'une option sous une matrice de chocs
+ */
+
+#include "scenarios.h" // Pour la déclaration de revaloriserScenarios
+#include "diff_finies.h" // Pour les classes Maillage et CrankNicholson
+#include "trace.h" // Pour les zones de trace des scénarios
+
+#include <map> // Pour std::map
+#include <memory> // Pour std::unique_ptr et std::make_shared
+#include <memory_resource> // Pour std::pmr::monotonic_buffer_resource
+#include <thread> // Pour std::thread
+#include <atomic> // Pour std::atomic
+#include <cmath> // Pour std::nan
+#include <cstdio> // Pour std::printf
+
+/**
+ * @brief Revalorise une option sous toutes les combinaisons de chocs spot x volatilité x taux
+ * @param option Option à revaloriser (Put ou Call)
+ * @param S0 Spot de référence
+ * @param chocsSpot Chocs relatifs sur le spot
+ * @param chocsVol Chocs absolus sur la volatilité
+ * @param chocsTaux Chocs absolus sur le taux d'intérêt
+ * @param M Nombre de pas de temps
+ * @param N Nombre de pas d'espace
+ * @param nbThreads Nombre de threads utilisés
+ * @return Prix de chaque scénario et nombre de résolutions effectuées (aucun scénario si l'option n'est ni un put ni un call)
+ */
+MatriceScenarios revaloriserScenarios(const Option& option, double S0, const std::vector<double>& chocsSpot, const std::vector<double>& chocsVol,
+                                      const std::vector<double>& chocsTaux, int M, int N, int nbThreads)
+{
+    MatriceScenarios matrice;
+    matrice.nbResolutions = 0;
+
+    bool call = dynamic_cast<const Call*>(&option) != nullptr;
+    if (!call && dynamic_cast<const Put*>(&option) == nullptr)
+    {
+        std::cout << "Erreur : la revalorisation par scénarios ne traite que les puts et les calls" << std::endl;
+        return matrice;
+    }
+
+    // Liste des scénarios et regroupement par opérateur : les scénarios de même (sigma, r) partagent une résolution
+    std::map<std::pair<double, double>, std::vector<int>> groupes;
+    for (double chocVol : chocsVol)
+    {
+        for (double chocTaux : chocsTaux)
+        {
+            for (double chocSpot : chocsSpot)
+            {
+                groupes[{option.getSigma() + chocVol, option.getR() + chocTaux}].push_back(matrice.scenarios.size());
+                matrice.scenarios.push_back({chocSpot, chocVol, chocTaux, std::nan("")});
+            }
+        }
+    }
+    std::vector<std::pair<double, double>> operateurs;
+    std::vector<std::vector<int>> indices;
+    for (const auto& groupe : groupes)
+    {
+        operateurs.push_back(groupe.first);
+        indices.push_back(groupe.second);
+        if (groupe.first.first > 0)
+        {
+            matrice.nbResolutions++;
+        }
+    }
+
+    // Tous les scénarios partagent le même maillage, et donc le même pas de temps
+    auto maillage = std::make_shared<const Maillage>(option.getT(), M, option.getL(), N);
+
+    // Les opérateurs sont distribués dynamiquement entre les threads
+    std::atomic<int> prochain(0);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < nbThreads; id++)
+    {
+        threads.emplace_back([&]()
+        {
+            // Chaque thread réutilise sa matrice solution et son arène d'une résolution à l'autre
+            std::vector<std::vector<double>> C;
+            std::pmr::monotonic_buffer_resource arene;
+
+            for (int k = prochain++; k < static_cast<int>(operateurs.size()); k = prochain++)
+            {
+                double sigma = operateurs[k].first;
+                double r = operateurs[k].second;
+                if (sigma <= 0)
+                {
+                    continue;
+                }
+
+                ZoneTrace zone("scenario");
+                std::unique_ptr<Option> choquee;
+                if (call)
+                {
+                    choquee.reset(new Call(option.getK(), option.getT(), option.getL(), r, sigma));
+                }
+                else
+                {
+                    choquee.reset(new Put(option.getK(), option.getT(), option.getL(), r, sigma));
+                }
+                EDPComplete edp(*choquee);
+                CrankNicholson(edp, maillage, &arene).solve(C);
+                arene.release();
+
+                // Les chocs de spot sont lus sur la tranche t = 0, sans nouvelle résolution
+                ZoneTrace sortie("sortie");
+                for (int indice : indices[k])
+                {
+                    Scenario& scenario = matrice.scenarios[indice];
+                    scenario.prix = maillage->interpoler(C[0], S0 * (1 + scenario.chocSpot));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return matrice;
+}
+
+/**
+ * @brief Affiche une matrice de scénarios, un tableau spot x volatilité par choc de taux
+ * @param titre Titre de la matrice
+ * @param matrice Résultat de la revalorisation
+ * @param nbSpot Nombre de chocs de spot
+ * @param nbVol Nombre de chocs de volatilité
+ * @param nbTaux Nombre de chocs de taux
+ */
+void afficherScenarios(const std::string& titre, const MatriceScenarios& matrice, int nbSpot, int nbVol, int nbTaux)
+{
+    std::printf("%s (%d résolutions pour %d scénarios)\n", titre.c_str(), matrice.nbResolutions, nbSpot * nbVol * nbTaux);
+    for (int l = 0; l < nbTaux; l++)
+    {
+        std::printf("Choc de taux %+g\n%10s", matrice.scenarios[l * nbSpot].chocTaux, "vol \\ spot");
+        for (int s = 0; s < nbSpot; s++)
+        {
+            std::printf(" %+9.1f%%", 100 * matrice.scenarios[s].chocSpot);
+        }
+        std::printf("\n");
+
+        for (int v = 0; v < nbVol; v++)
+        {
+            const Scenario* ligne = &matrice.scenarios[(v * nbTaux + l) * nbSpot];
+            std::printf("%+10.3f", ligne[0].chocVol);
+            for (int s = 0; s < nbSpot; s++)
+            {
+                std::printf(" %10.4f", ligne[s].prix);
+            }
+            std::printf("\n");
+        }
+        std::printf("\n");
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file scenarios.h
+ * @brief Déclarations du moteur de revalorisation d'une option sous une matrice de chocs spot x volatilité x taux
+ */
+
+#ifndef SCENARIOS_H
+#define SCENARIOS_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+
+#include <vector> // Pour std::vector
+#include <string> // Pour std::string
+
+/**
+ * @brief Structure contenant un scénario de choc et le prix de l'option dans ce scénario
+ */
+struct Scenario
+{
+    double chocSpot; // Choc relatif sur le spot (S = S0 * (1 + chocSpot))
+    double chocVol; // Choc absolu sur la volatilité
+    double chocTaux; // Choc absolu sur le taux d'intérêt
+    double prix; // Prix de l'option dans le scénario (NaN si le spot sort du domaine ou si la volatilité choquée est négative)
+};
+
+/**
+ * @brief Structure contenant le résultat d'une revalorisation sous une matrice de chocs
+ */
+struct MatriceScenarios
+{
+    std::vector<Scenario> scenarios; // Scénarios, ordonnés par choc de volatilité, puis de taux, puis de spot
+    int nbResolutions; // Nombre de résolutions de l'EDP effectuées, une par couple (sigma, r) distinct
+};
+
+/**
+ * @brief Revalorise une option sous toutes les combinaisons de chocs spot x volatilité x taux
+ *
+ * Les scénarios qui partagent la même volatilité et le même taux ont le même opérateur tridiagonal : ils sont servis par une
+ * seule résolution de Crank Nicholson, dont la factorisation est calculée une fois, et les chocs de spot sont lus directement
+ * sur la tranche t = 0 par interpolation linéaire. Les résolutions restantes sont réparties sur plusieurs threads, sur un
+ * maillage partagé
+ *
+ * @param option Option à revaloriser (Put ou Call)
+ * @param S0 Spot de référence
+ * @param chocsSpot Chocs relatifs sur le spot
+ * @param chocsVol Chocs absolus sur la volatilité
+ * @param chocsTaux Chocs absolus sur le taux d'intérêt
+ * @param M Nombre de pas de temps
+ * @param N Nombre de pas d'espace
+ * @param nbThreads Nombre de threads utilisés
+ * @return Prix de chaque scénario et nombre de résolutions effectuées (aucun scénario si l'option n'est ni un put ni un call)
+ */
+MatriceScenarios revaloriserScenarios(const Option& option, double S0, const std::vector<double>& chocsSpot, const std::vector<double>& chocsVol,
+                                      const std::vector<double>& chocsTaux, int M, int N, int nbThreads);
+
+/**
+ * @brief Affiche une matrice de scénarios, un tableau spot x volatilité par choc de taux
+ * @param titre Titre de la matrice
+ * @param matrice Résultat de la revalorisation
+ * @param nbSpot Nombre de chocs de spot
+ * @param nbVol Nombre de chocs de volatilité
+ * @param nbTaux Nombre de chocs de taux
+ */
+void afficherScenarios(const std::string& titre, const MatriceScenarios& matrice, int nbSpot, int nbVol, int nbTaux);
+
+#endif // SCENARIOS_H
@@ -14,7 +14,7 @@
  */
 SDL_Window* init_window(const std::string& title, int width, int height)
 {
-    SDL_Window* window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_SHOWN);
+    SDL_Window* window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
 
     if (window == nullptr)
     {
@@ -32,7 +32,7 @@ SDL_Window* init_window(const std::string& title, int width, int height)
  */
 SDL_Renderer* init_renderer(SDL_Window* window)
 {
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
     
     if (renderer == nullptr)
     {
@@ -63,17 +63,215 @@ void cleanup(SDL_Renderer* renderer, SDL_Window* window)
     }
 }
 
+/**
+ * @brief Convertit une valeur normalisée en couleur de la palette de la carte de chaleur
+ * @param u Valeur normalisée entre 0 et 1
+ * @return Couleur au format ARGB8888
+ */
+Uint32 heatmap_color(double u)
+{
+    // Points de contrôle de la palette, du violet foncé au jaune
+    static const double palette[5][3] = {{68, 1, 84}, {59, 82, 139}, {33, 145, 140}, {94, 201, 98}, {253, 231, 37}};
+
+    u = std::min(1.0, std::max(0.0, u)) * 4;
+    int k = std::min(3, static_cast<int>(u));
+    double a = u - k;
+
+    Uint32 couleur = 0xFF000000;
+    for (int c = 0; c < 3; c++)
+    {
+        Uint32 composante = static_cast<Uint32>(palette[k][c] + a * (palette[k+1][c] - palette[k][c]));
+        couleur |= composante << (16 - 8 * c);
+    }
+    return couleur;
+}
+
 /**
  * @brief Constructeur par défaut
  */
-Sdl::Sdl() : renderer_(nullptr), window_(nullptr) {} // Initialisation de renderer_ et window_ avec nullptr
+Sdl::Sdl() : renderer_(nullptr), window_(nullptr), cache_(nullptr), sale_(true), grille_min_(0), grille_max_(0), heatmap_(nullptr), heatmap_largeur_(0), heatmap_hauteur_(0) {} // Initialisation de renderer_ et window_ avec nullptr
 
 /**
  * @brief Constructeur
  * @param renderer Renderer SDL à utiliser pour dessiner les courbes
  * @param window Window SDL à utiliser pour dessiner les courbes
  */
-Sdl::Sdl(SDL_Renderer* renderer, SDL_Window* window) : renderer_(renderer), window_(window) {}
+Sdl::Sdl(SDL_Renderer* renderer, SDL_Window* window) : renderer_(renderer), window_(window), cache_(nullptr), sale_(true), grille_min_(0), grille_max_(0), heatmap_(nullptr), heatmap_largeur_(0), heatmap_hauteur_(0) {}
+
+/**
+ * @brief Ajoute une courbe à afficher dans la fenêtre
+ * @param x Vecteur correspondant aux abscisses
+ * @param y Vecteur correspondant aux odronnées
+ * @param color Couleur de la courbe, sous la forme d'un vecteur de trois entiers non signés de 8 bits
+ */
+void Sdl::add_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color)
+{
+    courbes_.push_back(create_curve(x, y, color));
+    sale_ = true;
+}
+
+/**
+ * @brief Affiche une grille complète (par exemple C(t, S) ou une grecque) en carte de chaleur sous les courbes
+ * @param grille Matrice des valeurs, chaque ligne correspondant à un temps et chaque colonne à une valeur de l'actif
+ */
+void Sdl::set_heatmap(const std::vector<std::vector<double>>& grille)
+{
+    grille_ = grille;
+
+    // Bornes des valeurs, utilisées pour normaliser la palette
+    grille_min_ = std::numeric_limits<double>::infinity();
+    grille_max_ = -std::numeric_limits<double>::infinity();
+    for (const auto& ligne : grille_)
+    {
+        auto bornes = std::minmax_element(ligne.begin(), ligne.end());
+        grille_min_ = std::min(grille_min_, *bornes.first);
+        grille_max_ = std::max(grille_max_, *bornes.second);
+    }
+
+    sale_ = true;
+}
+
+/**
+ * @brief Prépare une carte de chaleur vide, dont les lignes seront fournies au fur et à mesure du calcul
+ * @param nb_lignes Nombre de lignes (temps) de la grille
+ * @param nb_colonnes Nombre de colonnes (valeurs de l'actif) de la grille
+ */
+void Sdl::init_heatmap(int nb_lignes, int nb_colonnes)
+{
+    // Les noeuds pas encore calculés valent NaN et sont affichés en noir
+    grille_.assign(nb_lignes, std::vector<double>(nb_colonnes, std::numeric_limits<double>::quiet_NaN()));
+    grille_min_ = std::numeric_limits<double>::infinity();
+    grille_max_ = -std::numeric_limits<double>::infinity();
+    sale_ = true;
+}
+
+/**
+ * @brief Met à jour une ligne de la carte de chaleur
+ * @param i Indice de la ligne (temps)
+ * @param ligne Valeurs de la ligne
+ */
+void Sdl::update_heatmap_row(int i, const std::vector<double>& ligne)
+{
+    grille_[i] = ligne;
+
+    auto bornes = std::minmax_element(ligne.begin(), ligne.end());
+    grille_min_ = std::min(grille_min_, *bornes.first);
+    grille_max_ = std::max(grille_max_, *bornes.second);
+    sale_ = true;
+}
+
+/**
+ * @brief Change le titre de la fenêtre
+ * @param title Nouveau titre
+ */
+void Sdl::set_title(const std::string& title)
+{
+    if (window_ != nullptr)
+    {
+        SDL_SetWindowTitle(window_, title.c_str());
+    }
+}
+
+/**
+ * @brief Réduit la grille à la résolution de la zone de dessin et l'affiche en carte de chaleur
+ * @param zone Zone de la fenêtre dans laquelle on affiche la carte de chaleur
+ */
+void Sdl::draw_heatmap(const SDL_Rect& zone)
+{
+    int nb_lignes = grille_.size();
+    int nb_colonnes = grille_[0].size();
+
+    // La texture a au plus un pixel par noeud de la grille et au plus la résolution de la zone de dessin
+    int largeur = std::max(1, std::min(nb_colonnes, zone.w));
+    int hauteur = std::max(1, std::min(nb_lignes, zone.h));
+    if (heatmap_ == nullptr || largeur != heatmap_largeur_ || hauteur != heatmap_hauteur_)
+    {
+        if (heatmap_ != nullptr)
+        {
+            SDL_DestroyTexture(heatmap_);
+        }
+        heatmap_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, largeur, hauteur);
+        heatmap_largeur_ = largeur;
+        heatmap_hauteur_ = hauteur;
+    }
+
+    void* pixels;
+    int pitch;
+    if (heatmap_ == nullptr || SDL_LockTexture(heatmap_, nullptr, &pixels, &pitch) != 0)
+    {
+        std::cout << "Erreur lors de la création de la carte de chaleur : " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    const double echelle = grille_max_ > grille_min_ ? 1.0 / (grille_max_ - grille_min_) : 0.0;
+    std::vector<double> somme(nb_colonnes);
+
+    for (int py = 0; py < hauteur; py++)
+    {
+        // Le temps croît vers le haut : la ligne de pixels py couvre les lignes de la grille [i0, i1)
+        int i0 = static_cast<long>(hauteur - 1 - py) * nb_lignes / hauteur;
+        int i1 = static_cast<long>(hauteur - py) * nb_lignes / hauteur;
+
+        // Somme des lignes de la grille, colonne par colonne (boucle contiguë vectorisable)
+        std::fill(somme.begin(), somme.end(), 0.0);
+        for (int i = i0; i < i1; i++)
+        {
+            const double* ligne = grille_[i].data();
+            for (int j = 0; j < nb_colonnes; j++)
+            {
+                somme[j] += ligne[j];
+            }
+        }
+
+        // Moyenne de chaque bloc de colonnes, convertie en couleur
+        Uint32* rangee = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pixels) + py * pitch);
+        for (int px = 0; px < largeur; px++)
+        {
+            int j0 = static_cast<long>(px) * nb_colonnes / largeur;
+            int j1 = static_cast<long>(px + 1) * nb_colonnes / largeur;
+
+            double bloc = 0;
+            for (int j = j0; j < j1; j++)
+            {
+                bloc += somme[j];
+            }
+            double moyenne = bloc / ((i1 - i0) * (j1 - j0));
+            rangee[px] = std::isnan(moyenne) ? 0xFF000000 : heatmap_color((moyenne - grille_min_) * echelle);
+        }
+    }
+
+    SDL_UnlockTexture(heatmap_);
+    SDL_RenderCopy(renderer_, heatmap_, nullptr, &zone);
+}
+
+/**
+ * @brief Crée une courbe en calculant une seule fois ses bornes
+ * @param x Vecteur correspondant aux abscisses
+ * @param y Vecteur correspondant aux odronnées
+ * @param color Couleur de la courbe, sous la forme d'un vecteur de trois entiers non signés de 8 bits
+ * @return Courbe prête à être affichée
+ */
+Courbe create_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color)
+{
+    Courbe courbe;
+    courbe.x = x;
+    courbe.y = y;
+    courbe.color = color;
+
+    // Calculer les bornes de l'axe des x et des y (en unités de la courbe)
+    auto xbornes = std::minmax_element(x.begin(), x.end());
+    auto ybornes = std::minmax_element(y.begin(), y.end());
+    courbe.xmin = *xbornes.first;
+    courbe.xmax = *xbornes.second;
+    courbe.ymin = *ybornes.first;
+    courbe.ymax = *ybornes.second;
+
+    courbe.triee = std::is_sorted(x.begin(), x.end());
+    courbe.largeur = -1;
+    courbe.hauteur = -1;
+
+    return courbe;
+}
 
 /**
  * @brief Affiche une courbe dans la fenêtre
@@ -83,43 +281,80 @@ Sdl::Sdl(SDL_Renderer* renderer, SDL_Window* window) : renderer_(renderer), wind
  */
 void Sdl::draw_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color)
 {
-    // Calculer les dimensions de la fenêtre
-    int window_width = 640;
-    int window_height = 480;
+    Courbe courbe = create_curve(x, y, color);
+    draw_curve(courbe);
+}
+
+/**
+ * @brief Affiche une courbe dans la fenêtre en réutilisant ses points en pixels s'ils sont à jour
+ * @param courbe Courbe à afficher
+ */
+void Sdl::draw_curve(Courbe& courbe)
+{
+    // Récupérer les dimensions réelles de la fenêtre
+    int window_width, window_height;
+    SDL_GetRendererOutputSize(renderer_, &window_width, &window_height);
 
     // Définir les marges (en pixels) autour de la courbe
     int margin = 20;
 
-    // Calculer les dimensions de la zone de dessin (en pixels)
-    const int draw_width = window_width - 2 * margin;
-    const int draw_height = window_height - 2 * margin;
+    // On ne recalcule les points en pixels que si la taille de la fenêtre a changé
+    if (courbe.largeur != window_width || courbe.hauteur != window_height)
+    {
+        // Calculer les dimensions de la zone de dessin (en pixels)
+        const int draw_width = std::max(1, window_width - 2 * margin);
+        const int draw_height = std::max(1, window_height - 2 * margin);
 
-    // Calculer les bornes de l'axe des x et des y (en unités de la courbe)
-    double xmin = *std::min_element(x.begin(), x.end());
-    double xmax = *std::max_element(x.begin(), x.end());
-    double ymin = *std::min_element(y.begin(), y.end());
-    double ymax = *std::max_element(y.begin(), y.end());
+        // Calculer les échelles de l'axe des x et des y (en pixels/unité)
+        const double xscale = draw_width / (courbe.xmax > courbe.xmin ? courbe.xmax - courbe.xmin : 1.0);
+        const double yscale = draw_height / (courbe.ymax > courbe.ymin ? courbe.ymax - courbe.ymin : 1.0);
 
-    // Calculer les échelles de l'axe des x et des y (en pixels/unité)
-    const double xscale = static_cast<double>(draw_width) / (xmax - xmin);
-    const double yscale = static_cast<double>(draw_height) / (ymax - ymin);
+        std::vector<SDL_Point>& points = courbe.points;
+        points.clear();
 
-    // Définir la couleur de la courbe
-    SDL_SetRenderDrawColor(renderer_, color[0], color[1], color[2], 255);
+        if (courbe.triee && courbe.x.size() > 2 * static_cast<std::size_t>(draw_width))
+        {
+            // Décimation : on garde l'enveloppe minimum/maximum des points tombant dans chaque colonne de pixels
+            std::vector<double> colonne_min(draw_width + 1, std::numeric_limits<double>::infinity());
+            std::vector<double> colonne_max(draw_width + 1, -std::numeric_limits<double>::infinity());
+            for (std::size_t i = 0; i < courbe.x.size(); i++)
+            {
+                int colonne = static_cast<int>((courbe.x[i] - courbe.xmin) * xscale);
+                colonne_min[colonne] = std::min(colonne_min[colonne], courbe.y[i]);
+                colonne_max[colonne] = std::max(colonne_max[colonne], courbe.y[i]);
+            }
 
-    // Tracer la courbe
-    for (std::size_t i = 1; i < x.size(); i++)
-    {
-        // Calculer les coordonnées en pixels des points de la courbe
-        int x1 = static_cast<int>(margin + (x[i - 1] - xmin) * xscale);
-        int y1 = static_cast<int>(window_height - margin - (y[i - 1] - ymin) * yscale);
-        int x2 = static_cast<int>(margin + (x[i] - xmin) * xscale);
-        int y2 = static_cast<int>(window_height - margin - (y[i] - ymin) * yscale);
-
-        // Tracer une ligne entre les points de la courbe
-        SDL_RenderDrawLine(renderer_, x1, y1, x2, y2);
+            points.reserve(2 * (draw_width + 1));
+            for (int colonne = 0; colonne <= draw_width; colonne++)
+            {
+                if (colonne_min[colonne] > colonne_max[colonne])
+                {
+                    continue;
+                }
+                int px = margin + colonne;
+                points.push_back({px, static_cast<int>(window_height - margin - (colonne_min[colonne] - courbe.ymin) * yscale)});
+                points.push_back({px, static_cast<int>(window_height - margin - (colonne_max[colonne] - courbe.ymin) * yscale)});
+            }
+        }
+        else
+        {
+            // Calculer les coordonnées en pixels des points de la courbe
+            points.resize(courbe.x.size());
+            for (std::size_t i = 0; i < courbe.x.size(); i++)
+            {
+                points[i].x = static_cast<int>(margin + (courbe.x[i] - courbe.xmin) * xscale);
+                points[i].y = static_cast<int>(window_height - margin - (courbe.y[i] - courbe.ymin) * yscale);
+            }
+        }
+
+        courbe.largeur = window_width;
+        courbe.hauteur = window_height;
     }
 
+    // Tracer la courbe en un seul appel
+    SDL_SetRenderDrawColor(renderer_, courbe.color[0], courbe.color[1], courbe.color[2], 255);
+    SDL_RenderDrawLines(renderer_, courbe.points.data(), courbe.points.size());
+
     // Définir la couleur des lignes blanches
     SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
 
@@ -127,16 +362,74 @@ void Sdl::draw_curve(const std::vector<double>& x, const std::vector<double>& y,
     margin = 10;
 
     // Tracer les 4 lignes du cadre
-    SDL_RenderDrawLine(renderer_, margin, margin, window_width - margin, margin);
-    SDL_RenderDrawLine(renderer_, margin, margin, margin, window_height - margin);
-    SDL_RenderDrawLine(renderer_, margin, window_height - margin, window_width - margin, window_height - margin);
-    SDL_RenderDrawLine(renderer_, window_width - margin, margin, window_width - margin, window_height - margin);
+    const SDL_Point cadre[5] = {{margin, margin}, {window_width - margin, margin}, {window_width - margin, window_height - margin}, {margin, window_height - margin}, {margin, margin}};
+    SDL_RenderDrawLines(renderer_, cadre, 5);
 }
 
 /**
- * @brief Met à jour le renderer
+ * @brief Met à jour le renderer, en redessinant la texture cache seulement si nécessaire
  */
 void Sdl::show()
 {
+    if (renderer_ == nullptr)
+    {
+        return;
+    }
+
+    // On redessine les courbes dans la texture cache uniquement si elles ou la fenêtre ont changé
+    if (sale_ || cache_ == nullptr)
+    {
+        int width, height;
+        SDL_GetRendererOutputSize(renderer_, &width, &height);
+
+        if (cache_ != nullptr)
+        {
+            SDL_DestroyTexture(cache_);
+        }
+        cache_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+
+        SDL_SetRenderTarget(renderer_, cache_);
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+        SDL_RenderClear(renderer_);
+        if (!grille_.empty() && !grille_[0].empty())
+        {
+            const int margin = 20;
+            SDL_Rect zone = {margin, margin, std::max(1, width - 2 * margin), std::max(1, height - 2 * margin)};
+            draw_heatmap(zone);
+        }
+        for (auto& courbe : courbes_)
+        {
+            draw_curve(courbe);
+        }
+        SDL_SetRenderTarget(renderer_, nullptr);
+
+        sale_ = false;
+    }
+
+    // On recopie la texture cache dans la fenêtre
+    SDL_RenderClear(renderer_);
+    SDL_RenderCopy(renderer_, cache_, nullptr, nullptr);
     SDL_RenderPresent(renderer_);
 }
+
+/**
+ * @brief Ferme la fenêtre et libère la texture, le renderer et le window
+ */
+void Sdl::close()
+{
+    if (heatmap_ != nullptr)
+    {
+        SDL_DestroyTexture(heatmap_);
+        heatmap_ = nullptr;
+    }
+
+    if (cache_ != nullptr)
+    {
+        SDL_DestroyTexture(cache_);
+        cache_ = nullptr;
+    }
+
+    cleanup(renderer_, window_);
+    renderer_ = nullptr;
+    window_ = nullptr;
+}
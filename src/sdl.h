@@ -12,6 +12,7 @@
 #include <algorithm>  // Pour std::max et std::min
 #include <iostream> // Pour std::cout et std::endl
 #include <limits> // Pour std::numeric_limits
+#include <cmath> // Pour std::isnan
 
 /**
 * @brief Initialise la fenêtre SDL
@@ -34,14 +35,60 @@ SDL_Renderer* init_renderer(SDL_Window* window);
 */
 void cleanup(SDL_Renderer* renderer, SDL_Window* window);
 
+/**
+ * @brief Structure représentant une courbe à afficher
+ */
+struct Courbe
+{
+    std::vector<double> x; // Abscisses des points de la courbe
+    std::vector<double> y; // Ordonnées des points de la courbe
+    std::vector<Uint8> color; // Couleur de la courbe
+    double xmin, xmax, ymin, ymax; // Bornes de la courbe, calculées une seule fois
+    bool triee; // Vrai si les abscisses sont croissantes, ce qui autorise la décimation par colonne de pixels
+    std::vector<SDL_Point> points; // Points de la courbe en pixels, mis en cache entre deux affichages
+    int largeur, hauteur; // Dimensions de la fenêtre pour lesquelles les points ont été calculés (-1 si aucune)
+};
+
+/**
+* @brief Crée une courbe en calculant une seule fois ses bornes
+* @param x Vecteur correspondant aux abscisses
+* @param y Vecteur correspondant aux odronnées
+* @param color Couleur de la courbe, sous la forme d'un vecteur de trois entiers non signés de 8 bits
+* @return Courbe prête à être affichée
+*/
+Courbe create_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color);
+
+/**
+* @brief Convertit une valeur normalisée en couleur de la palette de la carte de chaleur
+* @param u Valeur normalisée entre 0 et 1
+* @return Couleur au format ARGB8888
+*/
+Uint32 heatmap_color(double u);
+
 /**
  * @brief Classe permettant d'afficher des courbes dans une fenêtre SDL
+ *
+ * Les courbes sont dessinées une seule fois dans une texture cache, qui n'est redessinée que lorsque les données
+ * ou la taille de la fenêtre changent ; chaque affichage se contente ensuite de recopier cette texture
  */
 class Sdl
 {
     private:
         SDL_Renderer* renderer_; // Renderer SDL utilisé pour dessiner les courbes
         SDL_Window* window_; // Window SDL utilisé pour dessiner les coubres
+        SDL_Texture* cache_; // Texture dans laquelle les courbes sont dessinées
+        std::vector<Courbe> courbes_; // Courbes affichées dans la fenêtre
+        bool sale_; // Vrai si la texture cache doit être redessinée
+        std::vector<std::vector<double>> grille_; // Grille affichée en carte de chaleur (ligne = temps, colonne = actif)
+        double grille_min_, grille_max_; // Bornes des valeurs de la grille, calculées une seule fois
+        SDL_Texture* heatmap_; // Texture de streaming dans laquelle la grille réduite est écrite
+        int heatmap_largeur_, heatmap_hauteur_; // Dimensions de la texture de streaming
+
+        /**
+        * @brief Réduit la grille à la résolution de la zone de dessin et l'affiche en carte de chaleur
+        * @param zone Zone de la fenêtre dans laquelle on affiche la carte de chaleur
+        */
+        void draw_heatmap(const SDL_Rect& zone);
 
     public:
         /**
@@ -59,7 +106,52 @@ class Sdl
         /**
         * @brief Destructeur
         */
-        ~Sdl() { cleanup(renderer_, window_); };
+        ~Sdl() { close(); };
+
+        /**
+        * @brief Getter de l'identifiant de la fenêtre
+        * @return Identifiant SDL de la fenêtre, ou 0 si elle est fermée
+        */
+        Uint32 getWindowID() const { return window_ != nullptr ? SDL_GetWindowID(window_) : 0; }
+
+        /**
+        * @brief Ajoute une courbe à afficher dans la fenêtre
+        * @param x Vecteur correspondant aux abscisses
+        * @param y Vecteur correspondant aux odronnées
+        * @param color Couleur de la courbe, sous la forme d'un vecteur de trois entiers non signés de 8 bits
+        */
+        void add_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color);
+
+        /**
+        * @brief Affiche une grille complète (par exemple C(t, S) ou une grecque) en carte de chaleur sous les courbes
+        * @param grille Matrice des valeurs, chaque ligne correspondant à un temps et chaque colonne à une valeur de l'actif
+        */
+        void set_heatmap(const std::vector<std::vector<double>>& grille);
+
+        /**
+        * @brief Prépare une carte de chaleur vide, dont les lignes seront fournies au fur et à mesure du calcul
+        * @param nb_lignes Nombre de lignes (temps) de la grille
+        * @param nb_colonnes Nombre de colonnes (valeurs de l'actif) de la grille
+        */
+        void init_heatmap(int nb_lignes, int nb_colonnes);
+
+        /**
+        * @brief Met à jour une ligne de la carte de chaleur
+        * @param i Indice de la ligne (temps)
+        * @param ligne Valeurs de la ligne
+        */
+        void update_heatmap_row(int i, const std::vector<double>& ligne);
+
+        /**
+        * @brief Change le titre de la fenêtre
+        * @param title Nouveau titre
+        */
+        void set_title(const std::string& title);
+
+        /**
+        * @brief Indique que la texture cache doit être redessinée (par exemple après un redimensionnement)
+        */
+        void invalidate() { sale_ = true; }
 
         /**
         * @brief Affiche une courbe dans la fenêtre
@@ -70,9 +162,24 @@ class Sdl
         void draw_curve(const std::vector<double>& x, const std::vector<double>& y, const std::vector<Uint8>& color);
 
         /**
-        * @brief Met à jour le renderer
+        * @brief Affiche une courbe dans la fenêtre en réutilisant ses points en pixels s'ils sont à jour
+        *
+        * Lorsque la courbe contient plus de points que la zone de dessin n'a de colonnes de pixels, elle est réduite
+        * à l'enveloppe minimum/maximum de chaque colonne, puis tracée en un seul appel à SDL_RenderDrawLines
+        *
+        * @param courbe Courbe à afficher
+        */
+        void draw_curve(Courbe& courbe);
+
+        /**
+        * @brief Met à jour le renderer, en redessinant la texture cache seulement si nécessaire
         */
         void show();
+
+        /**
+        * @brief Ferme la fenêtre et libère la texture, le renderer et le window
+        */
+        void close();
 };
 
 #endif // SDL_H
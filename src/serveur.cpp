@@ -0,0 +1,439 @@
+/**
+ * @file serveur.cpp
+ * @brief Implémentation de la classe ServeurPrix
+ */
+
+#include "serveur.h" // Pour la déclaration de la classe ServeurPrix
+#include "trace.h" // Pour les zones de trace des lots
+
+#include <sstream> // Pour std::istringstream et std::ostringstream
+#include <iomanip> // Pour std::setprecision
+#include <vector> // Pour std::vector
+#include <algorithm> // Pour std::min et std::max
+#include <cmath> // Pour std::lround
+#include <iterator> // Pour std::next
+#include <cstring> // Pour std::strncpy
+#include <cerrno> // Pour errno
+#include <csignal> // Pour std::signal
+
+#include <sys/socket.h> // Pour socket, bind, listen et accept
+#include <sys/un.h> // Pour sockaddr_un
+#include <unistd.h> // Pour read, write, close et unlink
+
+/**
+ * @brief Structure représentant une connexion cliente, fermée lorsque la dernière réponse qui la référence a été écrite
+ */
+struct Connexion
+{
+    int fd; // Descripteur de la socket du client
+
+    /**
+     * @brief Destructeur : ferme la socket du client
+     */
+    ~Connexion() { close(fd); }
+};
+
+/**
+ * @brief Écrit une réponse complète sur un descripteur, en reprenant après les écritures partielles
+ * @param fd Descripteur sur lequel on écrit
+ * @param reponse Réponse à écrire, sans le retour à la ligne final
+ */
+static void ecrireReponse(int fd, const std::string& reponse)
+{
+    std::string ligne = reponse + "\n";
+    std::size_t ecrit = 0;
+    while (ecrit < ligne.size())
+    {
+        ssize_t n = write(fd, ligne.data() + ecrit, ligne.size() - ecrit);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            // Le client est parti : la réponse est perdue
+            return;
+        }
+        ecrit += n;
+    }
+}
+
+/**
+ * @brief Retourne le prix d'un contrat en un point, par interpolation linéaire en S sur la tranche la plus proche de t
+ * @param maillage Maillage de la solution
+ * @param C Valeurs de la solution aux différentes valeurs de S et t
+ * @param S Valeur de l'actif (comprise entre 0 et L)
+ * @param t Temps (compris entre 0 et T)
+ * @return Prix de l'option
+ */
+static double interpoler(const Maillage& maillage, const std::vector<std::vector<double>>& C, double S, double t)
+{
+    const std::vector<double>& temps = maillage.getTemps();
+    const std::vector<double>& actif = maillage.getActif();
+    int M = maillage.getM();
+    int N = maillage.getN();
+    int i = std::min(std::max(static_cast<int>(std::lround((t - temps[0]) * maillage.getInvDt())), 0), M);
+
+    // Indice de la maille contenant S et position dans la maille
+    double u = (S - actif[0]) * maillage.getInvDS();
+    int j = std::min(std::max(static_cast<int>(u), 0), N - 1);
+    double a = u - j;
+
+    return (1 - a) * C[i][j] + a * C[i][j+1];
+}
+
+/**
+ * @brief Lit les requêtes d'un client ligne par ligne et les soumet au serveur
+ * @param serveur Serveur de prix
+ * @param connexion Connexion du client
+ */
+static void servirClient(ServeurPrix& serveur, std::shared_ptr<Connexion> connexion)
+{
+    std::string tampon;
+    char bloc[4096];
+    while (true)
+    {
+        ssize_t n = read(connexion->fd, bloc, sizeof(bloc));
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return;
+        }
+        tampon.append(bloc, n);
+
+        // On soumet toutes les lignes complètes reçues : elles pourront être servies dans le même lot
+        std::size_t debut = 0;
+        for (std::size_t fin = tampon.find('\n'); fin != std::string::npos; fin = tampon.find('\n', debut))
+        {
+            std::string ligne = tampon.substr(debut, fin - debut);
+            debut = fin + 1;
+            if (!ligne.empty() && ligne.back() == '\r')
+            {
+                ligne.pop_back();
+            }
+            if (!ligne.empty())
+            {
+                serveur.soumettre(ligne, [connexion](const std::string& reponse) { ecrireReponse(connexion->fd, reponse); });
+            }
+        }
+        tampon.erase(0, debut);
+    }
+}
+
+/**
+ * @brief Constructeur de la classe ServeurPrix : démarre le thread de traitement
+ * @param M Nombre de pas de temps des maillages
+ * @param N Nombre de pas d'espace des maillages
+ * @param capacite Nombre maximal de contrats gardés en mémoire
+ */
+ServeurPrix::ServeurPrix(int M, int N, std::size_t capacite)
+    : M_(M), N_(N), capacite_(capacite), enCours_(0), arret_(false), nbLots_(0), nbResolutions_(0), nbBlocs_(0), nbMaillages_(0)
+{
+    traitement_ = std::thread(&ServeurPrix::traiter, this);
+}
+
+/**
+ * @brief Destructeur : sert les requêtes restantes puis arrête le thread de traitement
+ */
+ServeurPrix::~ServeurPrix()
+{
+    {
+        std::lock_guard<std::mutex> verrou(mutex_);
+        arret_ = true;
+    }
+    nouvelleRequete_.notify_all();
+    traitement_.join();
+}
+
+/**
+ * @brief Analyse une ligne de requête et l'ajoute à la file
+ * @param ligne Ligne de requête, au format du protocole
+ * @param repondre Fonction qui transmet la réponse au client, appelée depuis le thread de traitement
+ */
+void ServeurPrix::soumettre(const std::string& ligne, std::function<void(const std::string&)> repondre)
+{
+    RequetePrix requete;
+    requete.repondre = repondre;
+    requete.t = 0;
+
+    // Les requêtes invalides passent aussi par la file : seul le thread de traitement écrit les réponses
+    std::istringstream flux(ligne);
+    std::string type;
+    flux >> requete.id >> type >> requete.K >> requete.T >> requete.r >> requete.sigma >> requete.S;
+    if (!flux || (type != "put" && type != "call"))
+    {
+        requete.erreur = "requête invalide, format attendu : <id> <put|call> <K> <T> <r> <sigma> <S> [t]";
+    }
+    else
+    {
+        // Le temps est optionnel, mais s'il est présent il doit être un nombre et terminer la ligne
+        std::string reste;
+        flux >> std::ws;
+        requete.call = (type == "call");
+        if (!flux.eof() && (!(flux >> requete.t) || flux >> reste))
+        {
+            requete.erreur = "t invalide, format attendu : <id> <put|call> <K> <T> <r> <sigma> <S> [t]";
+        }
+        else if (requete.K <= 0 || requete.T <= 0 || requete.sigma <= 0)
+        {
+            requete.erreur = "K, T et sigma doivent être strictement positifs";
+        }
+        else if (requete.S < 0 || requete.S > 3 * requete.K)
+        {
+            requete.erreur = "S doit être compris entre 0 et 3K";
+        }
+        else if (requete.t < 0 || requete.t > requete.T)
+        {
+            requete.erreur = "t doit être compris entre 0 et T";
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> verrou(mutex_);
+        file_.push_back(std::move(requete));
+        enCours_++;
+    }
+    nouvelleRequete_.notify_one();
+}
+
+/**
+ * @brief Attend que toutes les requêtes soumises aient été servies
+ */
+void ServeurPrix::attendre()
+{
+    std::unique_lock<std::mutex> verrou(mutex_);
+    lotTermine_.wait(verrou, [this]() { return enCours_ == 0; });
+}
+
+/**
+ * @brief Retourne le maillage partagé d'une maturité et d'un domaine, en le créant s'il n'est plus utilisé par aucun contrat
+ * @param T Maturité
+ * @param L Borne supérieure du domaine
+ * @return Maillage partagé
+ */
+std::shared_ptr<const Maillage> ServeurPrix::maillage(double T, double L)
+{
+    std::weak_ptr<const Maillage>& partage = maillages_[{T, L}];
+    std::shared_ptr<const Maillage> maillage = partage.lock();
+    if (!maillage)
+    {
+        maillage = std::make_shared<const Maillage>(T, M_, L, N_);
+        partage = maillage;
+    }
+    return maillage;
+}
+
+/**
+ * @brief Résout par un seul solve en bloc des contrats de même maillage et de même opérateur
+ * @param bloc Contrats à résoudre, dont la solution est écrite dans C
+ */
+void ServeurPrix::resoudre(const std::vector<ContratChaud*>& bloc)
+{
+    ZoneTrace zone("bloc");
+
+    // L'EDP du premier contrat fournit l'opérateur commun à tout le bloc
+    std::vector<const Option*> options;
+    for (ContratChaud* chaud : bloc)
+    {
+        options.push_back(chaud->option.get());
+    }
+    EDPComplete edp(*bloc[0]->option);
+    CrankNicholson solveur(edp, bloc[0]->maillage);
+    std::vector<std::vector<std::vector<double>>> C;
+    if (solveur.solve(options, C))
+    {
+        for (std::size_t p = 0; p < bloc.size(); p++)
+        {
+            bloc[p]->C = std::move(C[p]);
+        }
+    }
+
+    std::lock_guard<std::mutex> verrou(mutex_);
+    nbResolutions_ += bloc.size();
+    nbBlocs_++;
+}
+
+/**
+ * @brief Boucle du thread de traitement : vide la file par lots, regroupe les requêtes par contrat et résout en bloc les
+ * nouveaux contrats de même opérateur
+ */
+void ServeurPrix::traiter()
+{
+    while (true)
+    {
+        // On prend d'un coup toutes les requêtes arrivées depuis le lot précédent
+        std::deque<RequetePrix> lot;
+        long numero;
+        {
+            std::unique_lock<std::mutex> verrou(mutex_);
+            nouvelleRequete_.wait(verrou, [this]() { return arret_ || !file_.empty(); });
+            if (file_.empty())
+            {
+                return;
+            }
+            lot.swap(file_);
+            numero = ++nbLots_;
+        }
+        ZoneTrace zone("lot");
+
+        // Regroupement des requêtes par contrat
+        std::map<CleContrat, std::vector<RequetePrix*>> groupes;
+        for (auto& requete : lot)
+        {
+            if (!requete.erreur.empty())
+            {
+                requete.repondre(requete.id + " erreur " + requete.erreur);
+                continue;
+            }
+            groupes[CleContrat(requete.call, requete.K, requete.T, requete.r, requete.sigma)].push_back(&requete);
+        }
+
+        // Les contrats absents de la mémoire sont regroupés par maillage et par opérateur : le domaine est [0, 3K], de sorte que
+        // le put et le call d'un même strike partagent le maillage, et l'opérateur ne dépend que de r et sigma
+        std::map<CleOperateur, std::vector<ContratChaud*>> blocs;
+        for (auto& [cle, requetes] : groupes)
+        {
+            auto [trouve, nouveau] = contrats_.try_emplace(cle);
+            ContratChaud& chaud = trouve->second;
+            chaud.derniereUtilisation = numero;
+            if (nouveau)
+            {
+                const RequetePrix& requete = *requetes[0];
+                double L = 3 * requete.K;
+                if (requete.call)
+                {
+                    chaud.option.reset(new Call(requete.K, requete.T, L, requete.r, requete.sigma));
+                }
+                else
+                {
+                    chaud.option.reset(new Put(requete.K, requete.T, L, requete.r, requete.sigma));
+                }
+                chaud.maillage = maillage(requete.T, L);
+                blocs[CleOperateur(requete.T, L, requete.r, requete.sigma)].push_back(&chaud);
+            }
+        }
+
+        // Une seule marche rétrograde par bloc de contrats
+        for (auto& [cle, bloc] : blocs)
+        {
+            resoudre(bloc);
+        }
+
+        // Les requêtes ne coûtent plus qu'une interpolation dans la solution de leur contrat
+        for (auto& [cle, requetes] : groupes)
+        {
+            ZoneTrace zoneContrat("contrat");
+            const ContratChaud& chaud = contrats_[cle];
+            for (RequetePrix* requete : requetes)
+            {
+                std::ostringstream reponse;
+                if (chaud.C.empty())
+                {
+                    reponse << requete->id << " erreur résolution impossible";
+                }
+                else
+                {
+                    reponse << requete->id << " " << std::setprecision(10) << interpoler(*chaud.maillage, chaud.C, requete->S, requete->t);
+                }
+                requete->repondre(reponse.str());
+            }
+        }
+
+        // On libère les contrats les moins récemment utilisés au-delà de la capacité
+        while (contrats_.size() > capacite_)
+        {
+            auto ancien = contrats_.begin();
+            for (auto it = contrats_.begin(); it != contrats_.end(); ++it)
+            {
+                if (it->second.derniereUtilisation < ancien->second.derniereUtilisation)
+                {
+                    ancien = it;
+                }
+            }
+            contrats_.erase(ancien);
+        }
+
+        // Un maillage n'est plus référencé que par la table lorsque son dernier contrat a été libéré
+        for (auto it = maillages_.begin(); it != maillages_.end(); )
+        {
+            it = it->second.expired() ? maillages_.erase(it) : std::next(it);
+        }
+
+        {
+            std::lock_guard<std::mutex> verrou(mutex_);
+            enCours_ -= lot.size();
+            nbMaillages_ = maillages_.size();
+        }
+        lotTermine_.notify_all();
+    }
+}
+
+/**
+ * @brief Sert les requêtes lues sur l'entrée standard jusqu'à sa fermeture, les réponses étant écrites sur la sortie standard
+ */
+void ServeurPrix::servirEntreeStandard()
+{
+    std::string ligne;
+    while (std::getline(std::cin, ligne))
+    {
+        if (!ligne.empty())
+        {
+            soumettre(ligne, [](const std::string& reponse) { std::cout << reponse << std::endl; });
+        }
+    }
+    attendre();
+}
+
+/**
+ * @brief Sert les clients qui se connectent à une socket Unix, chacun sur son propre thread de lecture
+ * @param chemin Chemin de la socket
+ * @return Faux si la socket n'a pas pu être créée
+ */
+bool ServeurPrix::servirSocket(const std::string& chemin)
+{
+    // Un client qui se déconnecte avant sa réponse ne doit pas interrompre le serveur
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        std::cerr << "Erreur lors de la création de la socket : " << chemin << std::endl;
+        return false;
+    }
+
+    sockaddr_un adresse = {};
+    adresse.sun_family = AF_UNIX;
+    std::strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+    unlink(chemin.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) != 0 || listen(fd, 64) != 0)
+    {
+        std::cerr << "Erreur lors de l'ouverture de la socket : " << chemin << std::endl;
+        close(fd);
+        return false;
+    }
+
+    std::cerr << "Serveur de prix en écoute sur " << chemin << std::endl;
+    while (true)
+    {
+        int client = accept(fd, nullptr, nullptr);
+        if (client < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (client < 0)
+        {
+            break;
+        }
+
+        // Le thread de lecture se termine lorsque le client ferme la connexion
+        std::shared_ptr<Connexion> connexion(new Connexion{client});
+        std::thread(servirClient, std::ref(*this), connexion).detach();
+    }
+
+    close(fd);
+    unlink(chemin.c_str());
+    return true;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file serveur.h
+ * @brief Déclaration de la classe ServeurPrix, serveur de prix résident qui garde les solveurs chauds en mémoire
+ *
+ * Protocole texte, une requête par ligne : "<id> <put|call> <K> <T> <r> <sigma> <S> [t]". La réponse est "<id> <prix>" ou
+ * "<id> erreur <message>". Les réponses d'une même connexion peuvent arriver dans un ordre différent des requêtes : c'est
+ * l'identifiant qui permet de les associer
+ */
+
+#ifndef SERVEUR_H
+#define SERVEUR_H
+
+#include "diff_finies.h" // Pour les classes Maillage et CrankNicholson
+
+#include <string> // Pour std::string
+#include <deque> // Pour std::deque
+#include <map> // Pour std::map
+#include <tuple> // Pour std::tuple
+#include <vector> // Pour std::vector
+#include <memory> // Pour std::unique_ptr, std::shared_ptr et std::weak_ptr
+#include <functional> // Pour std::function
+#include <mutex> // Pour std::mutex
+#include <condition_variable> // Pour std::condition_variable
+#include <thread> // Pour std::thread
+
+/**
+ * @brief Structure représentant une requête de prix analysée, en attente de traitement
+ */
+struct RequetePrix
+{
+    std::string id; // Identifiant choisi par le client, recopié dans la réponse
+    bool call; // Vrai pour un call, faux pour un put
+    double K, T, r, sigma; // Paramètres du contrat
+    double S; // Valeur de l'actif
+    double t; // Temps d'évaluation (0 par défaut)
+    std::string erreur; // Message d'erreur si la requête est invalide (vide sinon)
+    std::function<void(const std::string&)> repondre; // Fonction qui transmet la réponse au client
+};
+
+/**
+ * @brief Classe qui sert des requêtes de prix depuis l'entrée standard ou une socket Unix
+ *
+ * Un thread de traitement unique vide la file des requêtes par lots. Les contrats d'un lot absents de la mémoire qui partagent
+ * un maillage (T, L) et un opérateur (r, sigma), par exemple le put et le call d'un même strike, sont résolus ensemble par
+ * un seul solve en bloc : une factorisation par pas sert à tout le bloc. Les solutions de chaque contrat restent en mémoire
+ * entre les lots, de sorte qu'une requête sur un contrat déjà vu ne coûte qu'une interpolation. Un maillage est libéré avec
+ * le dernier contrat qui l'utilise
+ */
+class ServeurPrix
+{
+    private:
+        using CleContrat = std::tuple<bool, double, double, double, double>; // Type, K, T, r et sigma d'un contrat
+        using CleOperateur = std::tuple<double, double, double, double>; // T, L, r et sigma : contrats résolus en bloc
+
+        /**
+         * @brief Structure contenant un contrat et sa solution gardée en mémoire
+         */
+        struct ContratChaud
+        {
+            std::unique_ptr<Option> option; // Option du contrat
+            std::shared_ptr<const Maillage> maillage; // Maillage partagé avec les contrats de même maturité et de même domaine
+            std::vector<std::vector<double>> C; // Valeurs de la solution aux différentes valeurs de S et t (vide si la résolution a échoué)
+            long derniereUtilisation; // Numéro du dernier lot ayant utilisé le contrat
+        };
+
+        int M_; // Nombre de pas de temps des maillages
+        int N_; // Nombre de pas d'espace des maillages
+        std::size_t capacite_; // Nombre maximal de contrats gardés en mémoire
+
+        std::mutex mutex_; // Protège la file, le compteur de requêtes en cours et l'indicateur d'arrêt
+        std::condition_variable nouvelleRequete_; // Signalé lorsqu'une requête est ajoutée à la file ou à l'arrêt
+        std::condition_variable lotTermine_; // Signalé lorsqu'un lot de requêtes a été servi
+        std::deque<RequetePrix> file_; // Requêtes en attente
+        int enCours_; // Nombre de requêtes soumises et pas encore servies
+        bool arret_; // Vrai lorsque le thread de traitement doit s'arrêter
+
+        std::map<CleContrat, ContratChaud> contrats_; // Contrats gardés chauds, utilisés uniquement par le thread de traitement
+        std::map<std::pair<double, double>, std::weak_ptr<const Maillage>> maillages_; // Maillages partagés par les contrats, par (T, L)
+        long nbLots_; // Nombre de lots traités
+        long nbResolutions_; // Nombre de contrats mis en mémoire (résolutions démarrées)
+        long nbBlocs_; // Nombre de solves en bloc
+        std::size_t nbMaillages_; // Nombre de maillages en mémoire à la fin du dernier lot
+
+        std::thread traitement_; // Thread de traitement des requêtes
+
+        /**
+         * @brief Boucle du thread de traitement : vide la file par lots, regroupe les requêtes par contrat et résout en bloc
+         * les nouveaux contrats de même opérateur
+         */
+        void traiter();
+
+        /**
+         * @brief Retourne le maillage partagé d'une maturité et d'un domaine, en le créant s'il n'est plus utilisé par aucun contrat
+         * @param T Maturité
+         * @param L Borne supérieure du domaine
+         * @return Maillage partagé
+         */
+        std::shared_ptr<const Maillage> maillage(double T, double L);
+
+        /**
+         * @brief Résout par un seul solve en bloc des contrats de même maillage et de même opérateur
+         * @param bloc Contrats à résoudre, dont la solution est écrite dans C
+         */
+        void resoudre(const std::vector<ContratChaud*>& bloc);
+
+    public:
+        /**
+         * @brief Constructeur de la classe ServeurPrix : démarre le thread de traitement
+         * @param M Nombre de pas de temps des maillages
+         * @param N Nombre de pas d'espace des maillages
+         * @param capacite Nombre maximal de contrats gardés en mémoire
+         */
+        ServeurPrix(int M, int N, std::size_t capacite);
+
+        /**
+         * @brief Destructeur : sert les requêtes restantes puis arrête le thread de traitement
+         */
+        ~ServeurPrix();
+
+        ServeurPrix(const ServeurPrix&) = delete;
+        ServeurPrix& operator=(const ServeurPrix&) = delete;
+
+        /**
+         * @brief Analyse une ligne de requête et l'ajoute à la file
+         * @param ligne Ligne de requête, au format du protocole
+         * @param repondre Fonction qui transmet la réponse au client, appelée depuis le thread de traitement
+         */
+        void soumettre(const std::string& ligne, std::function<void(const std::string&)> repondre);
+
+        /**
+         * @brief Attend que toutes les requêtes soumises aient été servies
+         */
+        void attendre();
+
+        /**
+         * @brief Sert les requêtes lues sur l'entrée standard jusqu'à sa fermeture, les réponses étant écrites sur la sortie standard
+         */
+        void servirEntreeStandard();
+
+        /**
+         * @brief Sert les clients qui se connectent à une socket Unix, chacun sur son propre thread de lecture
+         * @param chemin Chemin de la socket
+         * @return Faux si la socket n'a pas pu être créée
+         */
+        bool servirSocket(const std::string& chemin);
+
+        /**
+        * @brief Getter du nombre de lots traités
+        * @return Nombre de lots traités
+        */
+        long getNbLots() { std::lock_guard<std::mutex> verrou(mutex_); return nbLots_; }
+
+        /**
+        * @brief Getter du nombre de contrats mis en mémoire depuis le démarrage
+        * @return Nombre de résolutions démarrées
+        */
+        long getNbResolutions() { std::lock_guard<std::mutex> verrou(mutex_); return nbResolutions_; }
+
+        /**
+        * @brief Getter du nombre de solves en bloc depuis le démarrage
+        * @return Nombre de solves en bloc
+        */
+        long getNbBlocs() { std::lock_guard<std::mutex> verrou(mutex_); return nbBlocs_; }
+
+        /**
+        * @brief Getter du nombre de maillages en mémoire à la fin du dernier lot
+        * @return Nombre de maillages utilisés par les contrats gardés en mémoire
+        */
+        std::size_t getNbMaillages() { std::lock_guard<std::mutex> verrou(mutex_); return nbMaillages_; }
+};
+
+#endif // SERVEUR_H
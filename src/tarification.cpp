@@ -0,0 +1,104 @@
+/**
+ * @file tarification.cpp
+ * @brief Implémentation de la tarification d'une option en un spot sur une grille dimensionnée automatiquement
+ */
+
+#include "tarification.h" // Pour la déclaration de prixAutomatique
+#include "diff_finies.h" // Pour les classes Maillage et SchemaTheta
+
+#include <memory> // Pour std::unique_ptr et std::make_shared
+#include <cmath> // Pour std::sqrt, std::log, std::exp et std::ceil
+#include <algorithm> // Pour std::max et std::min
+
+// Constantes d'erreur du schéma, mesurées sur des puts et des calls de volatilité 8 % à 40 % et de maturité 1 mois à 2 ans
+const double CONSTANTE_ESPACE = 0.02; // Erreur en espace ~ CONSTANTE_ESPACE * K * (dS / (sigma sqrt(T) K))^2
+const double CONSTANTE_TEMPS = 0.004; // Erreur en temps extrapolée ~ CONSTANTE_TEMPS * K * sigma sqrt(T) / M^2
+const int N_MIN = 20; // Nombre minimal de pas d'espace
+const int N_MAX = 20000; // Nombre maximal de pas d'espace, atteint pour les volatilités ou maturités quasi nulles
+const int M_MIN = 2; // Nombre minimal de pas de temps de la résolution grossière
+
+/**
+ * @brief Choisit le domaine et la taille de la grille minimale qui atteint une tolérance sur le prix en un spot
+ * @param option Option à tarifer
+ * @param S0 Spot auquel on veut le prix
+ * @param tolerance Erreur maximale visée sur le prix
+ * @return Domaine et taille de la grille
+ */
+GrilleTarification dimensionnerGrille(const Option& option, double S0, double tolerance)
+{
+    // Volatilité et taux moyens sur la vie de l'option
+    double T = option.getT();
+    double K = option.getK();
+    double ecartType = std::sqrt(option.varianceTotale(0));
+    double r = -std::log(option.facteurActualisation(0)) / T;
+
+    // Au-delà de z écarts-types, la probabilité exp(-z^2 / 2) pondère un prix de l'ordre de K : on la garde sous la tolérance
+    GrilleTarification grille;
+    double z = std::sqrt(2 * std::log(std::max(K / tolerance, 10.0)));
+    grille.L = std::max(K, S0) * std::exp(std::max(r, 0.0) * T + z * ecartType);
+
+    // Moitié de la tolérance pour l'erreur en espace, moitié pour l'erreur en temps
+    double dS = ecartType * K * std::sqrt(tolerance / (2 * CONSTANTE_ESPACE * K));
+    grille.N = std::min(N_MAX, std::max(N_MIN, static_cast<int>(std::ceil(grille.L / dS))));
+    grille.M = std::max(M_MIN, static_cast<int>(std::ceil(std::sqrt(2 * CONSTANTE_TEMPS * K * ecartType / tolerance))));
+
+    return grille;
+}
+
+/**
+ * @brief Tarifie une option en un spot sur la grille minimale qui atteint une tolérance
+ * @param option Option à tarifer (Put ou Call à coefficients constants)
+ * @param S0 Spot auquel on veut le prix
+ * @param tolerance Erreur maximale visée sur le prix
+ * @return Prix et grille utilisée (prix NaN si l'option n'est pas tarifable)
+ */
+PrixSpot prixAutomatique(const Option& option, double S0, double tolerance)
+{
+    PrixSpot resultat;
+    resultat.prix = std::nan("");
+    resultat.grille = {0, 0, 0};
+
+    bool call = dynamic_cast<const Call*>(&option) != nullptr;
+    if (!call && dynamic_cast<const Put*>(&option) == nullptr)
+    {
+        std::cout << "Erreur : la tarification automatique ne traite que les puts et les calls" << std::endl;
+        return resultat;
+    }
+    if (!option.coefficientsConstants())
+    {
+        std::cout << "Erreur : la tarification automatique ne traite que les options à taux et volatilité constants" << std::endl;
+        return resultat;
+    }
+    if (tolerance <= 0 || S0 < 0 || option.getSigma() <= 0)
+    {
+        std::cout << "Erreur : la tolérance et la volatilité doivent être strictement positives et le spot positif" << std::endl;
+        return resultat;
+    }
+
+    // La même option, sur le domaine tronqué
+    resultat.grille = dimensionnerGrille(option, S0, tolerance);
+    std::unique_ptr<Option> tronquee;
+    if (call)
+    {
+        tronquee.reset(new Call(option.getK(), option.getT(), resultat.grille.L, option.getR(), option.getSigma()));
+    }
+    else
+    {
+        tronquee.reset(new Put(option.getK(), option.getT(), resultat.grille.L, option.getR(), option.getSigma()));
+    }
+    EDPComplete edp(*tronquee);
+
+    // Le schéma implicite a une erreur en temps d'ordre 1 sans oscillations au strike : l'extrapolation de Richardson entre
+    // M et 2M pas sur le même axe de l'actif élimine le terme d'ordre 1
+    const GrilleTarification& grille = resultat.grille;
+    auto grossier = std::make_shared<const Maillage>(option.getT(), grille.M, grille.L, grille.N);
+    auto fin = std::make_shared<const Maillage>(option.getT(), 2 * grille.M, grille.L, grille.N);
+    std::vector<std::vector<double>> C;
+    SchemaTheta(edp, grossier, 1).solve(C);
+    double prixGrossier = grossier->interpoler(C[0], S0);
+    SchemaTheta(edp, fin, 1).solve(C);
+    double prixFin = fin->interpoler(C[0], S0);
+
+    resultat.prix = 2 * prixFin - prixGrossier;
+    return resultat;
+}
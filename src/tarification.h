@@ -0,0 +1,57 @@
+/**
+ * @file tarification.h
+ * @brief Déclarations de la tarification d'une option en un spot, sur une grille dimensionnée automatiquement pour une tolérance
+ */
+
+#ifndef TARIFICATION_H
+#define TARIFICATION_H
+
+#include "option.h" // Pour la déclaration de la classe Option
+
+/**
+ * @brief Structure contenant le domaine et la taille d'une grille de tarification
+ */
+struct GrilleTarification
+{
+    double L; // Borne supérieure du domaine de l'actif
+    int M; // Nombre de pas de temps de la résolution grossière (la résolution fine en fait 2M)
+    int N; // Nombre de pas d'espace
+};
+
+/**
+ * @brief Structure contenant le prix d'une option en un spot et la grille utilisée
+ */
+struct PrixSpot
+{
+    double prix; // Prix de l'option au temps 0 (NaN si l'option ne peut pas être tarifée)
+    GrilleTarification grille; // Grille sur laquelle le prix a été calculé
+};
+
+/**
+ * @brief Choisit le domaine et la taille de la grille minimale qui atteint une tolérance sur le prix en un spot
+ *
+ * Le domaine [0, L] est tronqué à z écarts-types sigma sqrt(T) au-dessus du strike et du spot, z étant choisi pour que la
+ * probabilité de dépasser L soit négligeable devant la tolérance. Les pas d'espace et de temps sont dimensionnés à partir de
+ * l'échelle sigma sqrt(T) K sur laquelle le payoff est lissé, la tolérance étant répartie pour moitié entre les deux erreurs
+ *
+ * @param option Option à tarifer
+ * @param S0 Spot auquel on veut le prix
+ * @param tolerance Erreur maximale visée sur le prix
+ * @return Domaine et taille de la grille
+ */
+GrilleTarification dimensionnerGrille(const Option& option, double S0, double tolerance);
+
+/**
+ * @brief Tarifie une option en un spot sur la grille minimale qui atteint une tolérance
+ *
+ * L'EDP complète est résolue par le schéma implicite avec M puis 2M pas de temps sur le même axe de l'actif, et les deux prix
+ * sont combinés par extrapolation de Richardson, ce qui rend l'erreur en temps d'ordre 2
+ *
+ * @param option Option à tarifer (Put ou Call à coefficients constants)
+ * @param S0 Spot auquel on veut le prix
+ * @param tolerance Erreur maximale visée sur le prix
+ * @return Prix et grille utilisée (prix NaN si l'option n'est pas tarifable)
+ */
+PrixSpot prixAutomatique(const Option& option, double S0, double tolerance);
+
+#endif // TARIFICATION_H
@@ -0,0 +1,219 @@
+/**
+ * @file trace.cpp
+ * @brief Implémentation de la couche de traçage au format Chrome trace-event
+ */
+
+#include "trace.h" // Pour la déclaration de la classe Trace
+
+#include <vector> // Pour std::vector
+#include <memory> // Pour std::unique_ptr
+#include <mutex> // Pour std::mutex
+#include <chrono> // Pour std::chrono::steady_clock
+#include <cstdio> // Pour std::fopen et std::fprintf
+#include <iostream> // Pour std::cerr
+
+const std::size_t CAPACITE_TAMPON_TRACE = 1 << 16; // Nombre maximal d'événements par thread
+
+/**
+ * @brief Structure représentant un événement de trace
+ */
+struct EvenementTrace
+{
+    const char* nom; // Nom de la zone
+    char phase; // 'B' pour le début, 'E' pour la fin
+    long long ns; // Instant de l'événement, en nanosecondes depuis l'origine de la trace
+};
+
+/**
+ * @brief Structure représentant le tampon d'événements d'un thread, écrit uniquement par ce thread
+ */
+struct TamponTrace
+{
+    int tid; // Numéro du thread dans la trace
+    std::vector<EvenementTrace> evenements; // Événements, alloués une fois pour toutes
+    std::atomic<std::size_t> taille; // Nombre d'événements publiés
+    std::atomic<long> perdus; // Nombre d'événements perdus faute de place
+
+    /**
+     * @brief Constructeur de la structure TamponTrace
+     * @param numero Numéro du thread dans la trace
+     */
+    TamponTrace(int numero) : tid(numero), evenements(CAPACITE_TAMPON_TRACE), taille(0), perdus(0) {}
+};
+
+std::atomic<bool> Trace::active_(false);
+
+static std::mutex registreMutex; // Protège le registre des tampons
+static std::vector<std::unique_ptr<TamponTrace>> registre; // Tampons de tous les threads, qui survivent aux threads
+static std::vector<TamponTrace*> tamponsLibres; // Tampons des threads terminés, repris par les threads suivants
+
+/**
+ * @brief Structure qui détient le tampon d'un thread et le rend aux tampons libres à la fin du thread
+ */
+struct DetenteurTampon
+{
+    TamponTrace* tampon = nullptr; // Tampon du thread (nullptr tant que le thread n'a rien enregistré)
+
+    /**
+     * @brief Destructeur : le tampon et ses événements restent dans le registre, et pourront être complétés par un autre thread
+     */
+    ~DetenteurTampon()
+    {
+        if (tampon)
+        {
+            std::lock_guard<std::mutex> verrou(registreMutex);
+            tamponsLibres.push_back(tampon);
+        }
+    }
+};
+
+static thread_local DetenteurTampon tamponThread; // Tampon du thread courant
+static const std::chrono::steady_clock::time_point origine = std::chrono::steady_clock::now(); // Origine des temps de la trace
+
+/**
+ * @brief Active ou désactive l'enregistrement des événements
+ * @param active Vrai pour enregistrer les événements
+ */
+void Trace::activer(bool active)
+{
+    active_.store(active, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enregistre un événement dans le tampon du thread appelant
+ * @param nom Nom de la zone, chaîne littérale dont seule l'adresse est gardée
+ * @param phase 'B' pour le début d'une zone, 'E' pour sa fin
+ */
+void Trace::enregistrer(const char* nom, char phase)
+{
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origine).count();
+
+    // Au premier événement du thread, on reprend le tampon d'un thread terminé, à la suite de ses événements, ou on en enregistre
+    // un nouveau
+    TamponTrace*& tampon = tamponThread.tampon;
+    if (!tampon)
+    {
+        std::lock_guard<std::mutex> verrou(registreMutex);
+        if (!tamponsLibres.empty())
+        {
+            tampon = tamponsLibres.back();
+            tamponsLibres.pop_back();
+        }
+        else
+        {
+            registre.emplace_back(new TamponTrace(registre.size() + 1));
+            tampon = registre.back().get();
+        }
+    }
+
+    // Seul ce thread écrit dans son tampon : l'événement est publié pour l'écriture du fichier par le stockage de la taille
+    std::size_t taille = tampon->taille.load(std::memory_order_relaxed);
+    if (taille == CAPACITE_TAMPON_TRACE)
+    {
+        tampon->perdus.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    tampon->evenements[taille] = {nom, phase, ns};
+    tampon->taille.store(taille + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Écrit les événements de tous les threads au format Chrome trace-event
+ * @param chemin Chemin du fichier JSON à écrire
+ * @return Faux si le fichier n'a pas pu être écrit
+ */
+bool Trace::ecrire(const std::string& chemin)
+{
+    std::FILE* fichier = std::fopen(chemin.c_str(), "w");
+    if (!fichier)
+    {
+        std::cerr << "Erreur lors de l'ouverture du fichier de trace : " << chemin << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> verrou(registreMutex);
+    std::fprintf(fichier, "{\"traceEvents\": [\n");
+    bool premier = true;
+    for (const auto& tampon : registre)
+    {
+        // Les temps sont en microsecondes dans le format trace-event
+        std::size_t taille = tampon->taille.load(std::memory_order_acquire);
+        for (std::size_t k = 0; k < taille; k++)
+        {
+            const EvenementTrace& evenement = tampon->evenements[k];
+            std::fprintf(fichier, "%s{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 1, \"tid\": %d}", premier ? "" : ",\n",
+                         evenement.nom, evenement.phase, evenement.ns * 1e-3, tampon->tid);
+            premier = false;
+        }
+    }
+    std::fprintf(fichier, "\n], \"displayTimeUnit\": \"ns\"}\n");
+
+    bool succes = std::fclose(fichier) == 0;
+    if (!succes)
+    {
+        std::cerr << "Erreur lors de l'écriture du fichier de trace : " << chemin << std::endl;
+    }
+    return succes;
+}
+
+/**
+ * @brief Vide les tampons de tous les threads, qui ne doivent plus enregistrer d'événements
+ */
+void Trace::reinitialiser()
+{
+    std::lock_guard<std::mutex> verrou(registreMutex);
+    for (const auto& tampon : registre)
+    {
+        tampon->taille.store(0, std::memory_order_relaxed);
+        tampon->perdus.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Getter du nombre d'événements perdus faute de place dans les tampons
+ * @return Nombre d'événements perdus
+ */
+long Trace::getNbPerdus()
+{
+    std::lock_guard<std::mutex> verrou(registreMutex);
+    long perdus = 0;
+    for (const auto& tampon : registre)
+    {
+        perdus += tampon->perdus.load(std::memory_order_relaxed);
+    }
+    return perdus;
+}
+
+/**
+ * @brief Getter du nombre de tampons alloués depuis le démarrage
+ * @return Nombre de tampons, au plus le nombre maximal de threads tracés simultanément
+ */
+std::size_t Trace::getNbTampons()
+{
+    std::lock_guard<std::mutex> verrou(registreMutex);
+    return registre.size();
+}
+
+/**
+ * @brief Constructeur de la classe SessionTrace
+ * @param chemin Chemin du fichier à écrire, ou nullptr pour ne pas tracer
+ */
+SessionTrace::SessionTrace(const char* chemin) : chemin_(chemin ? chemin : "")
+{
+    if (!chemin_.empty())
+    {
+        Trace::activer(true);
+    }
+}
+
+/**
+ * @brief Destructeur : écrit la trace et la désactive
+ */
+SessionTrace::~SessionTrace()
+{
+    if (!chemin_.empty())
+    {
+        Trace::activer(false);
+        Trace::ecrire(chemin_);
+    }
+}
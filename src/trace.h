@@ -0,0 +1,137 @@
+/**
+ * @file trace.h
+ * @brief Déclarations de la couche de traçage optionnelle, qui enregistre les phases des résolutions au format Chrome trace-event
+ *
+ * Le fichier produit ({"traceEvents": [...]}) s'ouvre dans un visualiseur de traces local (chrome://tracing ou Perfetto) et
+ * montre, pour chaque thread, les résolutions et leurs phases (initialisation de la grille, marche en temps, sortie)
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic> // Pour std::atomic
+#include <string> // Pour std::string
+
+/**
+ * @brief Classe statique qui collecte les événements de trace dans un tampon par thread
+ *
+ * Chaque thread écrit dans son propre tampon de taille fixe, sans verrou : seul l'enregistrement du tampon, au premier
+ * événement du thread, prend un verrou. Les événements au-delà de la capacité du tampon sont perdus et comptés. Lorsque la
+ * trace est désactivée, une zone ne coûte qu'une lecture atomique. Le tampon d'un thread terminé, avec ses événements, est
+ * repris par le prochain thread qui s'enregistre : le nombre de tampons est borné par le nombre de threads tracés simultanément,
+ * et des threads successifs peuvent partager une ligne du visualiseur
+ */
+class Trace
+{
+    private:
+        static std::atomic<bool> active_; // Vrai si les événements sont enregistrés
+
+    public:
+        /**
+        * @brief Active ou désactive l'enregistrement des événements
+        * @param active Vrai pour enregistrer les événements
+        */
+        static void activer(bool active);
+
+        /**
+        * @brief Indique si l'enregistrement des événements est actif
+        * @return Vrai si les événements sont enregistrés
+        */
+        static bool estActive() { return active_.load(std::memory_order_relaxed); }
+
+        /**
+        * @brief Enregistre un événement dans le tampon du thread appelant
+        * @param nom Nom de la zone, chaîne littérale dont seule l'adresse est gardée
+        * @param phase 'B' pour le début d'une zone, 'E' pour sa fin
+        */
+        static void enregistrer(const char* nom, char phase);
+
+        /**
+        * @brief Écrit les événements de tous les threads au format Chrome trace-event
+        *
+        * Les threads tracés ne doivent plus enregistrer d'événements pendant l'écriture
+        *
+        * @param chemin Chemin du fichier JSON à écrire
+        * @return Faux si le fichier n'a pas pu être écrit
+        */
+        static bool ecrire(const std::string& chemin);
+
+        /**
+        * @brief Vide les tampons de tous les threads, qui ne doivent plus enregistrer d'événements
+        */
+        static void reinitialiser();
+
+        /**
+        * @brief Getter du nombre d'événements perdus faute de place dans les tampons
+        * @return Nombre d'événements perdus
+        */
+        static long getNbPerdus();
+
+        /**
+        * @brief Getter du nombre de tampons alloués depuis le démarrage
+        * @return Nombre de tampons, au plus le nombre maximal de threads tracés simultanément
+        */
+        static std::size_t getNbTampons();
+};
+
+/**
+ * @brief Zone de trace : enregistre un événement de début à la construction et un événement de fin à la destruction
+ */
+class ZoneTrace
+{
+    private:
+        const char* nom_; // Nom de la zone (nullptr si la trace était inactive à l'entrée dans la zone)
+
+    public:
+        /**
+        * @brief Constructeur de la classe ZoneTrace
+        * @param nom Nom de la zone, chaîne littérale
+        */
+        ZoneTrace(const char* nom) : nom_(Trace::estActive() ? nom : nullptr)
+        {
+            if (nom_)
+            {
+                Trace::enregistrer(nom_, 'B');
+            }
+        }
+
+        /**
+        * @brief Destructeur : ferme la zone si elle a été ouverte
+        */
+        ~ZoneTrace()
+        {
+            if (nom_)
+            {
+                Trace::enregistrer(nom_, 'E');
+            }
+        }
+
+        ZoneTrace(const ZoneTrace&) = delete;
+        ZoneTrace& operator=(const ZoneTrace&) = delete;
+};
+
+/**
+ * @brief Session de trace : active la trace si un chemin est donné et écrit le fichier à la destruction
+ */
+class SessionTrace
+{
+    private:
+        std::string chemin_; // Chemin du fichier à écrire (vide si la trace n'est pas demandée)
+
+    public:
+        /**
+        * @brief Constructeur de la classe SessionTrace
+        * @param chemin Chemin du fichier à écrire, ou nullptr pour ne pas tracer
+        */
+        SessionTrace(const char* chemin);
+
+        /**
+        * @brief Destructeur : écrit la trace et la désactive
+        */
+        ~SessionTrace();
+
+        SessionTrace(const SessionTrace&) = delete;
+        SessionTrace& operator=(const SessionTrace&) = delete;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,1330 @@
+/**
+ * @file test_solveurs.cpp
+ * @brief Tests sans interface graphique de la précision et des performances des solveurs
+ *
+ * Vérifie algoThomas sur des systèmes tridiagonaux connus, CrankNicholson contre le prix analytique de Black Scholes
+ * et la parité put-call, son ordre 2 en temps et sa variante à volatilité locale, Implicite contre la solution exacte de l'équation de la chaleur (NoyauChaleur),
+ * CrankNicholson sur une structure par termes contre la formule fermée et le refus des structures invalides, que les vecteurs
+ * de travail des solveurs tiennent dans une arène, qu'un même maillage peut être partagé entre threads, que la résolution
+ * paresseuse ne calcule que les tranches demandées, que les grilles rectangulaires (M différent de N) sont correctes, que le
+ * dernier temps du maillage est exactement la maturité, que le
+ * serveur de prix regroupe les requêtes d'un même contrat, que la matrice de scénarios partage les résolutions, que le
+ * theta-schéma explicite est exact sur une grille stable, que sa marche par blocs est identique à la marche pas à pas, que le
+ * solveur de taille fixe retrouve CrankNicholson, que la résolution en bloc d'une échelle de strikes retrouve les résolutions séparées
+ * en moins de temps, que la tarification sur grille automatique atteint sa tolérance, que le pas de
+ * temps adaptatif atteint sa tolérance avec bien moins de pas que le pas fixe, que la trace Chrome d'une revalorisation multi-thread
+ * est bien formée, que les options à barrière retrouvent la formule de Reiner et Rubinstein en surveillance continue et la
+ * correction de Broadie, Glasserman et Kou en surveillance discrète, que le générateur Philox retrouve ses vecteurs de
+ * référence, que MonteCarlo donne le même prix quel que soit le nombre de threads et retrouve les prix des solveurs, qu'un
+ * instantané relu donne les grilles écrites et qu'un instantané corrompu est refusé, que l'étude de convergence observe l'ordre
+ * des schémas et recommande une grille rectangulaire, et que le temps de résolution par noeud reste sous le budget enregistré. Le programme retourne 1 si un test échoue
+ *
+ * Compilation : g++ -O2 -pthread test/test_solveurs.cpp src/serveur.cpp src/scenarios.cpp src/tarification.cpp src/trace.cpp src/barriere.cpp src/monte_carlo.cpp src/instantane.cpp src/convergence.cpp src/diff_finies.cpp src/maillage.cpp src/edp.cpp src/option.cpp src/fft.cpp -o test_solveurs
+ */
+
+#include "../src/diff_finies.h" // Pour les classes CrankNicholson, Implicite et NoyauChaleur
+#include "../src/diff_finies_fixe.h" // Pour la classe CrankNicholsonFixe
+#include "../src/serveur.h" // Pour la classe ServeurPrix
+#include "../src/scenarios.h" // Pour revaloriserScenarios
+#include "../src/tarification.h" // Pour prixAutomatique
+#include "../src/trace.h" // Pour la classe Trace
+#include "../src/barriere.h" // Pour la classe OptionBarriere
+#include "../src/monte_carlo.h" // Pour les classes Philox et MonteCarlo
+#include "../src/instantane.h" // Pour ecrireInstantane et la classe Instantane
+#include "../src/convergence.h" // Pour etudeConvergence et recommanderGrille
+
+#include <chrono> // Pour std::chrono::steady_clock
+#include <cmath> // Pour std::abs
+#include <memory_resource> // Pour std::pmr::monotonic_buffer_resource
+#include <new> // Pour std::bad_alloc
+#include <thread> // Pour std::thread
+#include <utility> // Pour std::pair
+#include <map> // Pour std::map
+#include <mutex> // Pour std::mutex
+#include <sstream> // Pour std::istringstream et std::ostringstream
+#include <fstream> // Pour std::ifstream
+#include <set> // Pour std::set
+#include <cstdio> // Pour std::remove
+#include <cstring> // Pour std::memcpy
+#include <cstddef> // Pour offsetof
+#include <iterator> // Pour std::istreambuf_iterator
+
+const double BUDGET_NS_PAR_NOEUD = 150; // Budget de temps de CrankNicholson::solve en nanosecondes par noeud (mesuré autour de 15 ns en -O2)
+const double BUDGET_US_FIXE = 50; // Budget de temps de CrankNicholsonFixe<32, 32>::solve en microsecondes (mesuré autour de 5 us en -O2)
+
+int nb_echecs = 0; // Nombre de tests échoués
+
+/**
+ * @brief Affiche le résultat d'un test et comptabilise les échecs
+ * @param condition Vrai si le test est réussi
+ * @param nom Nom du test
+ * @param valeur Valeur mesurée, affichée pour faciliter le diagnostic
+ */
+void verifier(bool condition, const std::string& nom, double valeur)
+{
+    std::cout << (condition ? "[OK]     " : "[ECHEC]  ") << nom << " : " << valeur << std::endl;
+    if (!condition)
+    {
+        nb_echecs++;
+    }
+}
+
+/**
+ * @brief Construit une grille uniforme de n+1 points entre 0 et longueur
+ * @param n Nombre de pas
+ * @param longueur Borne supérieure de la grille
+ * @return Vecteur des points de la grille
+ */
+std::vector<double> grille(int n, double longueur)
+{
+    std::vector<double> v(n+1);
+    for (int k = 0; k <= n; k++)
+    {
+        v[k] = k * longueur / n;
+    }
+    v[n] = longueur;
+    return v;
+}
+
+/**
+ * @brief Teste algoThomas sur la matrice du laplacien discret et sur une matrice non symétrique
+ */
+void test_algoThomas()
+{
+    // Laplacien discret tridiag(-1, 2, -1) : la solution attendue est sol = (1, 2, ..., n)
+    int n = 6;
+    std::vector<double> x(n, -1), y(n, 2), z(n, -1), attendu(n), b(n);
+    for (int i = 0; i < n; i++)
+    {
+        attendu[i] = i + 1;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        b[i] = 2 * attendu[i] - (i > 0 ? attendu[i-1] : 0) - (i < n-1 ? attendu[i+1] : 0);
+    }
+    std::vector<double> sol = algoThomas(x, y, z, b);
+    double erreur = 0;
+    for (int i = 0; i < n; i++)
+    {
+        erreur = std::max(erreur, std::abs(sol[i] - attendu[i]));
+    }
+    verifier(erreur < 1e-12, "algoThomas, laplacien discret", erreur);
+
+    // Matrice non symétrique à diagonale dominante : on vérifie le résidu A * sol - b
+    x = {0, 1, -2, 0.5, 3, -1};
+    y = {5, 6, 7, 4, 9, 3};
+    z = {2, -1, 1, 1, -2, 0};
+    b = {1, -2, 3, 0.5, 4, -1};
+    sol = algoThomas(x, y, z, b);
+    double residu = 0;
+    for (int i = 0; i < n; i++)
+    {
+        double ligne = y[i] * sol[i] + (i > 0 ? x[i] * sol[i-1] : 0) + (i < n-1 ? z[i] * sol[i+1] : 0);
+        residu = std::max(residu, std::abs(ligne - b[i]));
+    }
+    verifier(residu < 1e-12, "algoThomas, matrice non symétrique", residu);
+}
+
+/**
+ * @brief Teste la parité put-call sur les prix analytiques
+ */
+void test_parite_analytique()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    Call call(100, 1, 300, 0.05, 0.2);
+
+    double erreur = 0;
+    for (double S = 50; S <= 150; S += 10)
+    {
+        erreur = std::max(erreur, std::abs(call.prixAnalytique(S, 0) - put.prixAnalytique(S, 0) - (S - 100 * std::exp(-0.05))));
+    }
+    verifier(erreur < 1e-10, "parité put-call des prix analytiques", erreur);
+}
+
+/**
+ * @brief Teste CrankNicholson contre le prix analytique et la parité put-call, ainsi que le budget de temps par noeud
+ */
+void test_crank_nicholson()
+{
+    int M = 400;
+    int N = 400;
+    std::vector<double> t = grille(M, 1);
+    std::vector<double> S = grille(N, 300);
+
+    Put put(100, 1, 300, 0.05, 0.2);
+    Call call(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp_put(put);
+    EDPComplete edp_call(call);
+
+    auto debut = std::chrono::steady_clock::now();
+    std::vector<std::vector<double>> C_put = CrankNicholson(edp_put, S, t).solve();
+    auto fin = std::chrono::steady_clock::now();
+    std::vector<std::vector<double>> C_call = CrankNicholson(edp_call, S, t).solve();
+
+    // Erreur par rapport au prix analytique et parité put-call au temps 0 autour du strike
+    double erreur_put = 0, erreur_call = 0, erreur_parite = 0;
+    for (int j = 0; j <= N; j++)
+    {
+        if (S[j] < 80 || S[j] > 120)
+        {
+            continue;
+        }
+        erreur_put = std::max(erreur_put, std::abs(C_put[0][j] - put.prixAnalytique(S[j], 0)));
+        erreur_call = std::max(erreur_call, std::abs(C_call[0][j] - call.prixAnalytique(S[j], 0)));
+        erreur_parite = std::max(erreur_parite, std::abs(C_call[0][j] - C_put[0][j] - (S[j] - 100 * std::exp(-0.05))));
+    }
+    verifier(erreur_put < 1e-2, "CrankNicholson, put contre Black Scholes", erreur_put);
+    verifier(erreur_call < 1e-2, "CrankNicholson, call contre Black Scholes", erreur_call);
+    verifier(erreur_parite < 2e-3, "CrankNicholson, parité put-call", erreur_parite);
+
+    // Budget de performance
+    double ns_par_noeud = std::chrono::duration<double, std::nano>(fin - debut).count() / ((M+1) * (N+1));
+    verifier(ns_par_noeud < BUDGET_NS_PAR_NOEUD, "CrankNicholson, temps par noeud (ns)", ns_par_noeud);
+}
+
+/**
+ * @brief Teste l'ordre 2 en temps de CrankNicholson, à axe de l'actif fixé, contre une référence à pas de temps très fin,
+ * ainsi que CrankNicholsonVolLocale à volatilité constante contre CrankNicholson, sur une surface en temps contre la formule
+ * fermée de la structure par termes et sur une surface en actif par la parité put-call
+ */
+void test_ordre_crank_nicholson()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+    std::vector<std::vector<double>> reference = CrankNicholson(edp, std::make_shared<const Maillage>(1, 1280, 300, 600)).solve();
+
+    // Diviser le pas de temps par 2 doit diviser l'erreur en temps par 4, y compris au voisinage du coin du payoff
+    double erreurs[2] = {0, 0};
+    for (int k = 0; k < 2; k++)
+    {
+        std::vector<std::vector<double>> C = CrankNicholson(edp, std::make_shared<const Maillage>(1, 20 << k, 300, 600)).solve();
+        for (int j = 100; j <= 300; j++)
+        {
+            erreurs[k] = std::max(erreurs[k], std::abs(C[0][j] - reference[0][j]));
+        }
+    }
+    double ordre = std::log2(erreurs[0] / erreurs[1]);
+    verifier(ordre > 1.8, "CrankNicholson, ordre en temps", ordre);
+
+    // À volatilité constante, la volatilité locale donne le même schéma
+    auto maillage = std::make_shared<const Maillage>(1, 50, 300, 300);
+    EDPVolLocale edp_locale(put, [](double, double) { return 0.2; });
+    std::vector<std::vector<double>> C_locale = CrankNicholsonVolLocale(edp_locale, maillage).solve();
+    std::vector<std::vector<double>> C = CrankNicholson(edp, maillage).solve();
+    double ecart = 0;
+    for (int j = 0; j <= 300; j++)
+    {
+        ecart = std::max(ecart, std::abs(C_locale[0][j] - C[0][j]));
+    }
+    verifier(ecart < 1e-10, "CrankNicholsonVolLocale à volatilité constante contre CrankNicholson", ecart);
+
+    // Surface qui ne dépend que du temps : c'est une structure par termes de la volatilité, dont la formule fermée utilise la
+    // variance intégrée. Le changement de volatilité tombe sur un temps du maillage
+    auto fin = std::make_shared<const Maillage>(1, 400, 300, 600);
+    const std::vector<double>& S = fin->getActif();
+    EDPVolLocale edp_temps(put, [](double, double t) { return t < 0.5 ? 0.15 : 0.3; });
+    std::vector<std::vector<double>> C_temps = CrankNicholsonVolLocale(edp_temps, fin).solve();
+    Put put_courbe(100, 1, 300, 0.05, 0.2);
+    put_courbe.setStructureParTermes({0.5, 1}, {0.05, 0.05}, {0.15, 0.3});
+    double erreur_temps = 0;
+    for (int j = 0; j <= 600; j++)
+    {
+        if (S[j] >= 80 && S[j] <= 120)
+        {
+            erreur_temps = std::max(erreur_temps, std::abs(C_temps[0][j] - put_courbe.prixAnalytique(S[j], 0)));
+        }
+    }
+    verifier(erreur_temps < 1e-3, "CrankNicholsonVolLocale, surface en temps contre la formule fermée de la structure par termes", erreur_temps);
+
+    // Surface qui dépend de l'actif (sourire) : sans formule fermée, mais le put et le call vérifient la parité, leur différence
+    // S - K exp(-r (T - t)) étant linéaire en S
+    auto sourire = [](double S, double t) { return 0.2 + 0.1 * (1 - t) * std::exp(-std::pow(S / 100 - 1, 2) / 0.05); };
+    Call call(100, 1, 300, 0.05, 0.2);
+    EDPVolLocale edp_sourire_put(put, sourire);
+    EDPVolLocale edp_sourire_call(call, sourire);
+    std::vector<std::vector<double>> C_put = CrankNicholsonVolLocale(edp_sourire_put, fin).solve();
+    std::vector<std::vector<double>> C_call = CrankNicholsonVolLocale(edp_sourire_call, fin).solve();
+    double erreur_parite = 0;
+    double ecart_sourire = 0;
+    for (int j = 0; j <= 600; j++)
+    {
+        erreur_parite = std::max(erreur_parite, std::abs(C_call[0][j] - C_put[0][j] - (S[j] - 100 * std::exp(-0.05))));
+        ecart_sourire = std::max(ecart_sourire, std::abs(C_put[0][j] - put.prixAnalytique(S[j], 0)));
+    }
+    verifier(erreur_parite < 1e-5 && ecart_sourire > 1e-1, "CrankNicholsonVolLocale, surface en actif et parité put-call", erreur_parite);
+}
+
+/**
+ * @brief Teste les structures par termes constantes par morceaux : intégrales du taux et de la variance, CrankNicholson sur une
+ * courbe à trois segments contre la formule fermée, et refus des structures invalides
+ */
+void test_structure_par_termes()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    Call call(100, 1, 300, 0.05, 0.2);
+    for (Option* option : {static_cast<Option*>(&put), static_cast<Option*>(&call)})
+    {
+        option->setStructureParTermes({0.25, 0.6, 1}, {0.02, 0.05, 0.03}, {0.15, 0.3, 0.2});
+    }
+
+    // Intégrales sur [0.1, 1] : 0.15 sur le premier segment, 0.35 sur le deuxième et 0.4 sur le dernier
+    double actualisation = std::exp(-(0.02 * 0.15 + 0.05 * 0.35 + 0.03 * 0.4));
+    double variance = 0.15 * 0.15 * 0.15 + 0.3 * 0.3 * 0.35 + 0.2 * 0.2 * 0.4;
+    double ecart_courbe = std::max(std::abs(put.facteurActualisation(0.1) - actualisation), std::abs(put.varianceTotale(0.1) - variance));
+    bool segments = put.getR(0.3) == 0.05 && put.getSigma(0.3) == 0.3 && put.getR(0.6) == 0.03 && put.getSigma(0.1) == 0.15;
+    verifier(segments && !put.coefficientsConstants() && ecart_courbe < 1e-15, "Structure par termes, segments et intégrales", ecart_courbe);
+
+    // Les dates de changement de segment sont des temps du maillage : une factorisation par segment
+    auto maillage = std::make_shared<const Maillage>(1, 400, 300, 600);
+    const std::vector<double>& S = maillage->getActif();
+    double erreur = 0;
+    for (Option* option : {static_cast<Option*>(&put), static_cast<Option*>(&call)})
+    {
+        EDPComplete edp(*option);
+        std::vector<std::vector<double>> C = CrankNicholson(edp, maillage).solve();
+        for (int j = 0; j <= 600; j++)
+        {
+            if (S[j] >= 80 && S[j] <= 120)
+            {
+                erreur = std::max(erreur, std::abs(C[0][j] - option->prixAnalytique(S[j], 0)));
+            }
+        }
+    }
+    verifier(erreur < 1e-3, "CrankNicholson, put et call sur une courbe à trois segments contre la formule fermée", erreur);
+
+    // Les structures invalides sont refusées et l'option garde sa courbe
+    std::ostringstream sortie;
+    std::streambuf* ancienneSortie = std::cout.rdbuf(sortie.rdbuf());
+    put.setStructureParTermes({0.6, 0.25, 1}, {0.02, 0.05, 0.03}, {0.15, 0.3, 0.2});
+    put.setStructureParTermes({0, 0.6, 1}, {0.02, 0.05, 0.03}, {0.15, 0.3, 0.2});
+    put.setStructureParTermes({0.25, 0.6, 1.5}, {0.02, 0.05, 0.03}, {0.15, 0.3, 0.2});
+    put.setStructureParTermes({0.25, 0.6, 1}, {0.02, 0.05, 0.03}, {0.15, -0.3, 0.2});
+    std::cout.rdbuf(ancienneSortie);
+    bool refusees = put.getR(0.3) == 0.05 && put.getSigma(0.3) == 0.3 && put.varianceTotale(0.1) == variance;
+    std::string messages = sortie.str();
+    bool signalees = std::count(messages.begin(), messages.end(), '\n') == 4;
+    verifier(refusees && signalees, "Structure par termes, dates désordonnées, hors de ]0, T] et volatilités négatives refusées", refusees);
+}
+
+/**
+ * @brief Teste Implicite contre la solution exacte de l'EDP réduite calculée par NoyauChaleur, ainsi que le repli de
+ * NoyauChaleur sur Implicite lorsque les coefficients ne sont pas constants
+ */
+void test_implicite()
+{
+    int M = 400;
+    int N = 400;
+    std::vector<double> t = grille(M, 1);
+    std::vector<double> S = grille(N, 300);
+
+    Put put(100, 1, 300, 0.05, 2);
+    EDPReduite edp(put);
+
+    std::vector<std::vector<double>> C = Implicite(edp, S, t).solve();
+    std::vector<double> exact = NoyauChaleur(edp, S, t).solve(0.0);
+
+    double erreur = 0;
+    for (int j = 0; j <= N; j++)
+    {
+        if (S[j] >= 50 && S[j] <= 150)
+        {
+            erreur = std::max(erreur, std::abs(C[0][j] - exact[j]));
+        }
+    }
+    verifier(erreur < 1e-2, "Implicite, put contre le noyau de la chaleur", erreur);
+
+    // Coefficients non constants : NoyauChaleur se rabat sur Implicite, dont la marche n'est faite qu'une fois pour toutes
+    // les tranches demandées
+    Put put_courbe(100, 1, 300, 0.05, 2);
+    put_courbe.setStructureParTermes({0.5, 1}, {0.03, 0.06}, {1.5, 2});
+    EDPReduite edp_courbe(put_courbe);
+    std::vector<std::vector<double>> C_courbe = Implicite(edp_courbe, S, t).solve();
+    NoyauChaleur repli(edp_courbe, S, t);
+    auto debut = std::chrono::steady_clock::now();
+    std::vector<double> tranche0 = repli.solve(0.0);
+    auto milieu = std::chrono::steady_clock::now();
+    double ecart = 0;
+    for (int i = 0; i <= M; i += M / 10)
+    {
+        std::vector<double> tranche = repli.solve(t[i]);
+        for (int j = 0; j <= N; j++)
+        {
+            ecart = std::max(ecart, std::abs(tranche[j] - C_courbe[i][j]));
+        }
+    }
+    auto fin = std::chrono::steady_clock::now();
+    for (int j = 0; j <= N; j++)
+    {
+        ecart = std::max(ecart, std::abs(tranche0[j] - C_courbe[0][j]));
+    }
+    verifier(ecart == 0, "NoyauChaleur, repli sur Implicite pour des coefficients non constants", ecart);
+    verifier(fin - milieu < milieu - debut, "NoyauChaleur, une seule marche de repli pour 11 tranches",
+             std::chrono::duration<double, std::micro>(fin - milieu).count());
+}
+
+/**
+ * @brief Ressource mémoire qui compte les allocations qu'elle reçoit avant de les transmettre au tas
+ */
+class CompteurMemoire : public std::pmr::memory_resource
+{
+    public:
+        int nbAllocations = 0; // Nombre d'allocations reçues
+
+    private:
+        void* do_allocate(std::size_t taille, std::size_t alignement) override
+        {
+            nbAllocations++;
+            return std::pmr::new_delete_resource()->allocate(taille, alignement);
+        }
+
+        void do_deallocate(void* p, std::size_t taille, std::size_t alignement) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, taille, alignement);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& autre) const noexcept override { return this == &autre; }
+};
+
+/**
+ * @brief Teste que CrankNicholson et Implicite n'allouent leurs vecteurs de travail que dans l'arène fournie, et que le cache
+ * de SchemaAdaptatif passe par la ressource fournie
+ *
+ * L'arène n'a pas de ressource amont : toute allocation qui la déborde lève std::bad_alloc. On enchaîne plusieurs contrats
+ * en vidant l'arène entre deux résolutions et en réutilisant la même matrice solution
+ */
+void test_arene()
+{
+    int M = 200;
+    int N = 200;
+    std::vector<double> t = grille(M, 1);
+    std::vector<double> S = grille(N, 300);
+
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp_complete(put);
+    EDPReduite edp_reduite(put);
+    std::vector<std::vector<double>> reference_cn = CrankNicholson(edp_complete, S, t).solve();
+    std::vector<std::vector<double>> reference_implicite = Implicite(edp_reduite, S, t).solve();
+
+    // 5 vecteurs de N+1 doubles par résolution (factorisation, second membre et solution)
+    static char tampon[16 * 1024];
+    std::pmr::monotonic_buffer_resource arene(tampon, sizeof(tampon), std::pmr::null_memory_resource());
+
+    std::vector<std::vector<double>> C;
+    double ecart = 0;
+    try
+    {
+        for (int contrat = 0; contrat < 3; contrat++)
+        {
+            CrankNicholson(edp_complete, S, t, &arene).solve(C);
+            for (int j = 0; j <= N; j++)
+            {
+                ecart = std::max(ecart, std::abs(C[0][j] - reference_cn[0][j]));
+            }
+            arene.release();
+
+            Implicite(edp_reduite, S, t, &arene).solve(C);
+            for (int j = 0; j <= N; j++)
+            {
+                ecart = std::max(ecart, std::abs(C[0][j] - reference_implicite[0][j]));
+            }
+            arene.release();
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        ecart = std::nan("");
+    }
+    verifier(ecart == 0, "CrankNicholson et Implicite dans une arène", ecart);
+
+    // Chaque niveau en cache de SchemaAdaptatif alloue un noeud et six vecteurs, auxquels s'ajoutent les poids et les trois
+    // tranches de travail : toutes ces allocations passent par la ressource fournie
+    CompteurMemoire compteur;
+    SchemaAdaptatif adaptatif(edp_complete, std::make_shared<const Maillage>(t, S), 1e-3, &compteur);
+    adaptatif.solve();
+    int attendues = 7 * adaptatif.getNbFactorisations() + 4;
+    verifier(compteur.nbAllocations >= attendues, "SchemaAdaptatif, cache et vecteurs de travail dans la ressource fournie", compteur.nbAllocations);
+}
+
+/**
+ * @brief Teste que des solveurs lancés en parallèle sur un même maillage partagé retrouvent la solution d'un solveur isolé
+ */
+void test_maillage_partage()
+{
+    int M = 200;
+    int N = 200;
+    std::vector<double> t = grille(M, 1);
+    std::vector<double> S = grille(N, 300);
+    auto maillage = std::make_shared<const Maillage>(1.0, M, 300.0, N);
+
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+    std::vector<std::vector<double>> reference = CrankNicholson(edp, S, t).solve();
+
+    // Chaque thread résout le même contrat sur le maillage partagé, sans synchronisation
+    std::vector<std::vector<std::vector<double>>> C(4);
+    std::vector<std::thread> threads;
+    for (int k = 0; k < 4; k++)
+    {
+        threads.emplace_back([&, k]()
+        {
+            C[k] = CrankNicholson(edp, maillage).solve();
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    double ecart = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        for (int j = 0; j <= N; j++)
+        {
+            ecart = std::max(ecart, std::abs(C[k][0][j] - reference[0][j]));
+        }
+    }
+    verifier(ecart < 1e-12, "CrankNicholson sur un maillage partagé entre threads", ecart);
+}
+
+/**
+ * @brief Teste que CrankNicholsonParesseux ne descend que jusqu'au temps demandé et retrouve la résolution complète
+ */
+void test_paresseux()
+{
+    int M = 200;
+    int N = 200;
+    auto maillage = std::make_shared<const Maillage>(1.0, M, 300.0, N);
+
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+    std::vector<std::vector<double>> reference = CrankNicholson(edp, maillage).solve();
+
+    CrankNicholsonParesseux paresseux(edp, maillage);
+    const std::vector<double>& milieu = paresseux.solve(0.5);
+    bool arret_milieu = paresseux.getIndiceCalcule() == M / 2;
+
+    // Un temps postérieur est déjà mémorisé : aucune tranche supplémentaire n'est calculée
+    paresseux.solve(0.75);
+    bool memorise = paresseux.getIndiceCalcule() == M / 2;
+
+    // Un temps antérieur reprend la marche depuis la tranche M / 2
+    const std::vector<double>& initiale = paresseux.solve(0.0);
+
+    double ecart = 0;
+    for (int j = 0; j <= N; j++)
+    {
+        ecart = std::max(ecart, std::abs(milieu[j] - reference[M / 2][j]));
+        ecart = std::max(ecart, std::abs(initiale[j] - reference[0][j]));
+    }
+    verifier(arret_milieu && memorise, "CrankNicholsonParesseux, tranches calculées à la demande", paresseux.getIndiceCalcule());
+    verifier(ecart == 0, "CrankNicholsonParesseux contre la résolution complète", ecart);
+}
+
+/**
+ * @brief Teste CrankNicholson et Implicite sur des grilles rectangulaires, avec beaucoup plus de pas d'espace que de pas de temps et inversement
+ */
+void test_grille_rectangulaire()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp_complete(put);
+    EDPReduite edp_reduite(put);
+
+    for (auto [M, N] : {std::pair<int, int>(100, 1600), std::pair<int, int>(800, 200)})
+    {
+        auto maillage = std::make_shared<const Maillage>(1.0, M, 300.0, N);
+        const std::vector<double>& S = maillage->getActif();
+
+        std::vector<std::vector<double>> C = CrankNicholson(edp_complete, maillage).solve();
+        std::vector<std::vector<double>> D = Implicite(edp_reduite, maillage).solve();
+        std::vector<double> exact = NoyauChaleur(edp_reduite, maillage).solve(0.0);
+
+        bool dimensions = C.size() == static_cast<std::size_t>(M+1) && C[0].size() == static_cast<std::size_t>(N+1)
+                       && D.size() == static_cast<std::size_t>(M+1) && D[0].size() == static_cast<std::size_t>(N+1);
+
+        double erreur_cn = 0, erreur_implicite = 0;
+        for (int j = 0; j <= N; j++)
+        {
+            if (S[j] >= 80 && S[j] <= 120)
+            {
+                erreur_cn = std::max(erreur_cn, std::abs(C[0][j] - put.prixAnalytique(S[j], 0)));
+                erreur_implicite = std::max(erreur_implicite, std::abs(D[0][j] - exact[j]));
+            }
+        }
+
+        std::string grille = " (M = " + std::to_string(M) + ", N = " + std::to_string(N) + ")";
+        verifier(dimensions, "dimensions des matrices solution" + grille, C.size());
+        verifier(erreur_cn < 2e-2, "CrankNicholson, put contre Black Scholes" + grille, erreur_cn);
+        verifier(erreur_implicite < 2e-2, "Implicite, put contre le noyau de la chaleur" + grille, erreur_implicite);
+    }
+}
+
+/**
+ * @brief Teste que le serveur de prix sert des requêtes concurrentes avec une seule résolution par contrat, rejette les
+ * requêtes invalides et libère les maillages avec leurs contrats
+ */
+void test_serveur()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    Call call(100, 1, 300, 0.05, 0.2);
+
+    ServeurPrix serveur(200, 800, 16);
+    std::mutex mutex;
+    std::map<std::string, std::string> reponses;
+
+    // Quatre clients soumettent en même temps des requêtes sur deux contrats, dont une invalide
+    std::vector<std::thread> clients;
+    for (int k = 0; k < 4; k++)
+    {
+        clients.emplace_back([&, k]()
+        {
+            for (int l = 0; l < 10; l++)
+            {
+                std::string id = std::to_string(k) + "-" + std::to_string(l);
+                std::string type = (l % 2 == 0) ? "put" : "call";
+                serveur.soumettre(id + " " + type + " 100 1 0.05 0.2 " + std::to_string(80 + 4 * l), [&, id](const std::string& reponse)
+                {
+                    std::lock_guard<std::mutex> verrou(mutex);
+                    reponses[id] = reponse;
+                });
+            }
+        });
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+    serveur.soumettre("invalide put 100", [&](const std::string& reponse)
+    {
+        std::lock_guard<std::mutex> verrou(mutex);
+        reponses["invalide"] = reponse;
+    });
+    serveur.soumettre("temps put 100 1 0.05 0.2 90 abc", [&](const std::string& reponse)
+    {
+        std::lock_guard<std::mutex> verrou(mutex);
+        reponses["temps"] = reponse;
+    });
+    serveur.attendre();
+
+    double erreur = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        for (int l = 0; l < 10; l++)
+        {
+            std::string id = std::to_string(k) + "-" + std::to_string(l);
+            std::istringstream flux(reponses[id]);
+            std::string id_reponse;
+            double prix = std::nan("");
+            flux >> id_reponse >> prix;
+            const Option& option = (l % 2 == 0) ? static_cast<const Option&>(put) : static_cast<const Option&>(call);
+            erreur = std::max(erreur, id_reponse == id ? std::abs(prix - option.prixAnalytique(80 + 4 * l, 0)) : std::nan(""));
+        }
+    }
+    verifier(erreur < 2e-2, "ServeurPrix, prix contre Black Scholes", erreur);
+    verifier(serveur.getNbResolutions() == 2, "ServeurPrix, une résolution par contrat", serveur.getNbResolutions());
+    verifier(reponses["invalide"].find("invalide erreur") == 0, "ServeurPrix, requête invalide", reponses.size());
+    verifier(reponses["temps"].find("temps erreur") == 0, "ServeurPrix, temps invalide", reponses.size());
+    verifier(serveur.getNbBlocs() >= 1 && serveur.getNbBlocs() <= 2, "ServeurPrix, put et call résolus en bloc", serveur.getNbBlocs());
+
+    // Avec un seul contrat en mémoire, le maillage d'un strike est libéré avec son contrat
+    ServeurPrix petit(50, 100, 1);
+    std::string dernier;
+    for (int K : {90, 100, 110})
+    {
+        petit.soumettre("k put " + std::to_string(K) + " 1 0.05 0.2 100", [&](const std::string& reponse) { dernier = reponse; });
+        petit.attendre();
+    }
+    verifier(petit.getNbMaillages() == 1, "ServeurPrix, maillages libérés avec leurs contrats", petit.getNbMaillages());
+    verifier(dernier.find("k erreur") == std::string::npos, "ServeurPrix, prix après libération", 0);
+}
+
+/**
+ * @brief Teste la matrice de scénarios contre les prix analytiques des options choquées et le regroupement par opérateur
+ */
+void test_scenarios()
+{
+    Call call(100, 1, 300, 0.05, 0.2);
+
+    // Le choc de volatilité nul apparaît deux fois : il ne doit être résolu qu'une fois par choc de taux
+    std::vector<double> chocs_spot = {-0.2, -0.1, 0, 0.1, 0.2};
+    std::vector<double> chocs_vol = {-0.05, 0, 0.05, 0};
+    std::vector<double> chocs_taux = {-0.01, 0.01};
+    MatriceScenarios matrice = revaloriserScenarios(call, 100, chocs_spot, chocs_vol, chocs_taux, 200, 800, 3);
+
+    double erreur = 0;
+    for (const Scenario& scenario : matrice.scenarios)
+    {
+        Call choquee(100, 1, 300, 0.05 + scenario.chocTaux, 0.2 + scenario.chocVol);
+        erreur = std::max(erreur, std::abs(scenario.prix - choquee.prixAnalytique(100 * (1 + scenario.chocSpot), 0)));
+    }
+    verifier(matrice.scenarios.size() == 40 && erreur < 2e-2, "Scénarios, call choqué contre Black Scholes", erreur);
+    verifier(matrice.nbResolutions == 6, "Scénarios, une résolution par couple (sigma, r)", matrice.nbResolutions);
+}
+
+/**
+ * @brief Solveur de test qui effectue la marche du theta-schéma pas à pas, sans découpage en blocs
+ */
+class SchemaThetaPasAPas : public SchemaTheta
+{
+    public:
+        using SchemaTheta::SchemaTheta;
+
+        /**
+        * @brief Calcule la solution pas à pas dans une matrice initialisée par un premier appel à solve
+        * @param C Matrice dont seules les tranches intérieures sont recalculées
+        */
+        void marcher(std::vector<std::vector<double>>& C)
+        {
+            for (int i = getM()-1; i >= 0; i--)
+            {
+                pas(i, C[i+1], C[i]);
+            }
+        }
+};
+
+/**
+ * @brief Teste le theta-schéma : précision des schémas explicite et de Crank Nicholson, choix automatique, marche par blocs et repli stable
+ */
+void test_schema_theta()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+
+    // Grille grossière en espace : le schéma explicite est stable pour dt <= 2 / rho(L), soit environ M >= 400
+    auto grossier = std::make_shared<const Maillage>(1, 500, 300, 100);
+    SchemaTheta automatique(edp, grossier, SchemaTheta::THETA_AUTOMATIQUE);
+    std::vector<std::vector<double>> C_explicite = automatique.solve();
+    SchemaTheta trop_long(edp, std::make_shared<const Maillage>(1, 100, 300, 100), SchemaTheta::THETA_AUTOMATIQUE);
+    verifier(automatique.getTheta() == 0 && trop_long.getTheta() == 0.5, "SchemaTheta, choix automatique du schéma", automatique.getTheta());
+
+    auto fin = std::make_shared<const Maillage>(1, 400, 300, 400);
+    std::vector<std::vector<double>> C_cn = SchemaTheta(edp, fin, 0.5).solve();
+    double erreur_explicite = 0, erreur_cn = 0;
+    for (int j = 0; j <= 400; j++)
+    {
+        double S = fin->getActif()[j];
+        if (S >= 80 && S <= 120)
+        {
+            erreur_cn = std::max(erreur_cn, std::abs(C_cn[0][j] - put.prixAnalytique(S, 0)));
+        }
+    }
+    for (int j = 0; j <= 100; j++)
+    {
+        double S = grossier->getActif()[j];
+        if (S >= 80 && S <= 120)
+        {
+            erreur_explicite = std::max(erreur_explicite, std::abs(C_explicite[0][j] - put.prixAnalytique(S, 0)));
+        }
+    }
+    verifier(erreur_explicite < 1e-2, "SchemaTheta explicite, put contre Black Scholes", erreur_explicite);
+    verifier(erreur_cn < 1e-2, "SchemaTheta avec theta = 1/2, put contre Black Scholes", erreur_cn);
+
+    // Faible volatilité : le schéma explicite reste stable sur une grille assez large pour plusieurs tuiles, et M n'est pas
+    // un multiple de la hauteur des blocs
+    Put calme(100, 1, 300, 0.05, 0.01);
+    EDPComplete edp_calme(calme);
+    auto large = std::make_shared<const Maillage>(1, 200, 300, 1200);
+    SchemaThetaPasAPas explicite(edp_calme, large, 0);
+    std::vector<std::vector<double>> C_blocs = explicite.solve();
+    std::vector<std::vector<double>> C_pas = C_blocs;
+    explicite.marcher(C_pas);
+    double ecart = 0;
+    for (int i = 0; i <= 200; i++)
+    {
+        for (int j = 0; j <= 1200; j++)
+        {
+            ecart = std::max(ecart, std::abs(C_blocs[i][j] - C_pas[i][j]));
+        }
+    }
+    verifier(ecart == 0, "SchemaTheta explicite, marche par blocs contre marche pas à pas", ecart);
+
+    // Un schéma explicite instable est remplacé par le schéma implicite pour la résolution en cours seulement, et signalé sur la
+    // sortie d'erreur : la sortie standard porte les réponses du serveur de prix
+    SchemaTheta instable(edp, fin, 0);
+    std::ostringstream sortie, erreurs;
+    std::streambuf* ancienneSortie = std::cout.rdbuf(sortie.rdbuf());
+    std::streambuf* anciennesErreurs = std::cerr.rdbuf(erreurs.rdbuf());
+    std::vector<std::vector<double>> C_instable = instable.solve();
+    std::cout.rdbuf(ancienneSortie);
+    std::cerr.rdbuf(anciennesErreurs);
+    verifier(std::abs(C_instable[0][133] - put.prixAnalytique(fin->getActif()[133], 0)) < 2e-2,
+             "SchemaTheta, repli sur le schéma implicite si instable", C_instable[0][133]);
+    verifier(instable.getTheta() == 0, "SchemaTheta, repli limité à la résolution en cours", instable.getTheta());
+    verifier(sortie.str().empty() && !erreurs.str().empty(), "SchemaTheta, repli signalé sur la sortie d'erreur", sortie.str().size());
+}
+
+/**
+ * @brief Teste CrankNicholsonFixe contre CrankNicholson sur la même grille, ainsi que son budget de temps
+ */
+void test_fixe()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+
+    CrankNicholsonFixe<64, 128> fixe(edp);
+    fixe.solve();
+    std::vector<std::vector<double>> C = CrankNicholson(edp, std::make_shared<const Maillage>(1, 64, 300, 128)).solve();
+    double ecart = 0;
+    for (int j = 0; j <= 128; j++)
+    {
+        ecart = std::max(ecart, std::abs(fixe.getTranche()[j] - C[0][j]));
+    }
+    verifier(ecart < 1e-10, "CrankNicholsonFixe contre CrankNicholson", ecart);
+    verifier(std::abs(fixe.prix(100) - put.prixAnalytique(100, 0)) < 1e-2, "CrankNicholsonFixe, prix interpolé contre Black Scholes", fixe.prix(100));
+
+    // Call sur un domaine que le pas ne divise pas exactement en flottants (15 * (250 / 15) != 250) : le bord haut doit
+    // recevoir S - K exp(-r (T - t)), que le payoff ne reconnaît qu'en S = L exactement
+    Call call(100, 1, 250, 0.05, 0.2);
+    EDPComplete edp_call(call);
+    CrankNicholsonFixe<32, 15> inexact(edp_call);
+    inexact.solve();
+    std::vector<std::vector<double>> C_call = CrankNicholson(edp_call, std::make_shared<const Maillage>(1, 32, 250, 15)).solve();
+    double ecart_call = 0;
+    for (int j = 0; j <= 15; j++)
+    {
+        ecart_call = std::max(ecart_call, std::abs(inexact.getTranche()[j] - C_call[0][j]));
+    }
+    bool bord = std::abs(inexact.getTranche()[15] - (250 - 100 * std::exp(-0.05))) < 1e-12 && std::abs(inexact.prix(250) - inexact.getTranche()[15]) < 1e-9;
+    verifier(bord && ecart_call < 1e-10, "CrankNicholsonFixe<32, 15>, call avec L / N inexact contre CrankNicholson", ecart_call);
+    verifier(std::abs(inexact.prix(150) - call.prixAnalytique(150, 0)) < 0.5, "CrankNicholsonFixe<32, 15>, call contre Black Scholes", inexact.prix(150));
+
+    // Budget de performance sur une petite grille de cotation, en moyenne sur plusieurs résolutions
+    CrankNicholsonFixe<32, 32> cotation(edp);
+    auto debut = std::chrono::steady_clock::now();
+    for (int k = 0; k < 100; k++)
+    {
+        cotation.solve();
+    }
+    auto fin = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(fin - debut).count() / 100;
+    verifier(us < BUDGET_US_FIXE, "CrankNicholsonFixe<32, 32>, temps de résolution (us)", us);
+}
+
+/**
+ * @brief Teste la tarification sur grille automatique contre Black Scholes pour des contrats de volatilités et maturités variées,
+ * dont des maturités non dyadiques
+ */
+void test_tarification()
+{
+    Put put(100, 1, 300, 0.05, 0.2);
+    Put court(100, 0.1, 300, 0.02, 0.08);
+    Call volatil(100, 2, 300, 0.05, 0.4);
+    Call hors_monnaie(50, 0.25, 300, 0.01, 0.15);
+    std::vector<std::pair<const Option*, double>> contrats = {{&put, 100}, {&put, 80}, {&court, 100}, {&volatil, 90}, {&hors_monnaie, 55}};
+
+    for (double tolerance : {1e-2, 1e-3})
+    {
+        double pire = 0;
+        for (const auto& contrat : contrats)
+        {
+            PrixSpot resultat = prixAutomatique(*contrat.first, contrat.second, tolerance);
+            pire = std::max(pire, std::abs(resultat.prix - contrat.first->prixAnalytique(contrat.second, 0)) / tolerance);
+        }
+        verifier(pire <= 1, "prixAutomatique, erreur rapportée à la tolérance " + std::to_string(tolerance), pire);
+    }
+
+    // Maturités non dyadiques avec très peu de pas de temps : le dernier noeud de temps doit être exactement T, sinon le payoff
+    // n'est pas posé à maturité et le prix s'effondre
+    Put dixieme(100, 0.1, 300, 0.05, 0.2);
+    Put sept_dixiemes(100, 0.7, 300, 0.05, 0.2);
+    for (double tolerance : {3e-2, 1e-2, 1e-3})
+    {
+        double pire = 0;
+        for (const Option* contrat : {&dixieme, &sept_dixiemes})
+        {
+            PrixSpot resultat = prixAutomatique(*contrat, 100, tolerance);
+            pire = std::max(pire, std::abs(resultat.prix - contrat->prixAnalytique(100, 0)) / tolerance);
+        }
+        verifier(pire <= 1, "prixAutomatique, maturités non dyadiques, erreur rapportée à la tolérance " + std::to_string(tolerance), pire);
+    }
+
+    // Contrat court et peu volatil : la grille automatique est bien plus petite que la grille fixe 200 x 1000 de main.cpp
+    GrilleTarification grille = dimensionnerGrille(court, 100, 1e-2);
+    int noeuds = 3 * grille.M * grille.N;
+    verifier(noeuds * 10 < 200 * 1000 && grille.L < 120, "prixAutomatique, noeuds pour un contrat court et peu volatil", noeuds);
+}
+
+/**
+ * @brief Teste le pas de temps adaptatif contre Black Scholes et contre le noyau de la chaleur, et compte ses pas
+ */
+void test_adaptatif()
+{
+    int N = 1000;
+    auto maillage = std::make_shared<const Maillage>(1, 1000, 300, N);
+    Put put(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+
+    for (double tolerance : {1e-2, 1e-3})
+    {
+        SchemaAdaptatif adaptatif(edp, maillage, tolerance);
+        std::vector<std::vector<double>> C = adaptatif.solve();
+        double erreur = 0;
+        for (int j = 0; j <= N; j++)
+        {
+            double S = maillage->getActif()[j];
+            if (S >= 80 && S <= 120)
+            {
+                erreur = std::max(erreur, std::abs(C[0][j] - put.prixAnalytique(S, 0)));
+            }
+        }
+        bool temps = adaptatif.getTemps().front() == 0 && adaptatif.getTemps().back() == 1 && C.size() == adaptatif.getTemps().size();
+        verifier(temps && erreur < tolerance, "SchemaAdaptatif, put contre Black Scholes à la tolérance " + std::to_string(tolerance), erreur);
+    }
+
+    // Le pas fixe du schéma implicite demande M = 1000 pour une erreur de 1e-3
+    SchemaAdaptatif adaptatif(edp, maillage, 1e-2);
+    adaptatif.solve();
+    verifier(adaptatif.getNbPas() * 10 < 1000 && adaptatif.getNbFactorisations() < 20, "SchemaAdaptatif, nombre de pas", adaptatif.getNbPas());
+
+    // EDP réduite : même opérateur générique, contre la solution exacte
+    std::vector<double> t = grille(400, 1);
+    std::vector<double> S = grille(400, 300);
+    Put reduit(100, 1, 300, 0.05, 2);
+    EDPReduite edp_reduite(reduit);
+    std::vector<std::vector<double>> C = SchemaAdaptatif(edp_reduite, std::make_shared<const Maillage>(t, S), 1e-3).solve();
+    std::vector<double> exact = NoyauChaleur(edp_reduite, S, t).solve(0.0);
+    double erreur = 0;
+    for (int j = 0; j <= 400; j++)
+    {
+        if (S[j] >= 50 && S[j] <= 150)
+        {
+            erreur = std::max(erreur, std::abs(C[0][j] - exact[j]));
+        }
+    }
+    verifier(erreur < 1e-2, "SchemaAdaptatif, EDP réduite contre le noyau de la chaleur", erreur);
+}
+
+/**
+ * @brief Teste la résolution en bloc d'une échelle de strikes contre les résolutions séparées, et son temps
+ */
+void test_bloc()
+{
+    auto maillage = std::make_shared<const Maillage>(1.0, 200, 300.0, 1000);
+    std::vector<std::unique_ptr<Option>> echelle;
+    std::vector<const Option*> options;
+    for (int k = 0; k < 16; k++)
+    {
+        echelle.emplace_back(k % 2 ? static_cast<Option*>(new Call(70 + 4 * k, 1, 300, 0.05, 0.2)) : new Put(70 + 4 * k, 1, 300, 0.05, 0.2));
+        options.push_back(echelle.back().get());
+    }
+
+    for (double theta : {1.0, 0.5})
+    {
+        EDPComplete edp(*options[0]);
+        std::vector<std::vector<std::vector<double>>> C;
+        auto debut = std::chrono::steady_clock::now();
+        bool resolu = SchemaTheta(edp, maillage, theta).solve(options, C);
+        double duree_bloc = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+
+        std::vector<std::vector<std::vector<double>>> seules(16);
+        debut = std::chrono::steady_clock::now();
+        for (int p = 0; p < 16; p++)
+        {
+            EDPComplete edp_seule(*options[p]);
+            SchemaTheta(edp_seule, maillage, theta).solve(seules[p]);
+        }
+        double duree_separee = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+
+        double ecart = resolu ? 0 : 1;
+        for (int p = 0; p < 16 && resolu; p++)
+        {
+            for (int i = 0; i <= 200; i++)
+            {
+                for (int j = 0; j <= 1000; j++)
+                {
+                    ecart = std::max(ecart, std::abs(C[p][i][j] - seules[p][i][j]));
+                }
+            }
+        }
+        std::string suffixe = ", theta = " + std::to_string(theta);
+        verifier(ecart < 1e-12, "Bloc de 16 strikes contre résolutions séparées" + suffixe, ecart);
+        verifier(duree_bloc < duree_separee, "Bloc de 16 strikes, temps rapporté aux résolutions séparées" + suffixe, duree_bloc / duree_separee);
+    }
+
+    // Une option d'une autre volatilité n'a pas le même opérateur
+    Call autre(100, 1, 300, 0.05, 0.3);
+    options.push_back(&autre);
+    EDPComplete edp(*options[0]);
+    std::vector<std::vector<std::vector<double>>> C;
+    bool resolu = CrankNicholson(edp, maillage).solve(options, C);
+    verifier(!resolu && C.empty(), "Bloc refusé pour des volatilités différentes", resolu);
+}
+
+/**
+ * @brief Teste la trace Chrome d'une revalorisation sur plusieurs threads : zones équilibrées, plusieurs threads, aucun événement perdu,
+ * puis la reprise des tampons des threads terminés
+ */
+void test_trace()
+{
+    const std::string chemin = "test_solveurs_trace.json";
+    Put put(100, 1, 300, 0.05, 0.2);
+    // Assez de résolutions pour que plusieurs threads en prennent une
+    std::vector<double> chocs_vol = {-0.1, -0.05, 0, 0.05, 0.1, 0.15, 0.2, 0.25};
+
+    Trace::activer(true);
+    revaloriserScenarios(put, 100, {-0.1, 0, 0.1}, chocs_vol, {0}, 200, 800, 3);
+    Trace::activer(false);
+    bool ecrit = Trace::ecrire(chemin);
+
+    // Chaque ligne du fichier est un événement : on compte les débuts, les fins et les threads distincts
+    std::ifstream fichier(chemin);
+    std::string ligne;
+    int debuts = 0;
+    int fins = 0;
+    std::set<std::string> threads;
+    while (std::getline(fichier, ligne))
+    {
+        debuts += ligne.find("\"ph\": \"B\"") != std::string::npos;
+        fins += ligne.find("\"ph\": \"E\"") != std::string::npos;
+        std::size_t tid = ligne.find("\"tid\": ");
+        if (tid != std::string::npos)
+        {
+            threads.insert(ligne.substr(tid, ligne.find('}', tid) - tid));
+        }
+    }
+    fichier.close();
+    std::remove(chemin.c_str());
+
+    verifier(ecrit && debuts > 0 && debuts == fins, "Trace, zones ouvertes et fermées", debuts);
+    verifier(threads.size() >= 2, "Trace, événements de plusieurs threads", threads.size());
+    verifier(Trace::getNbPerdus() == 0, "Trace, aucun événement perdu", Trace::getNbPerdus());
+    Trace::reinitialiser();
+
+    // Des threads successifs reprennent les tampons des threads terminés, sans perdre leurs événements
+    std::size_t tampons = Trace::getNbTampons();
+    Trace::activer(true);
+    for (int k = 0; k < 50; k++)
+    {
+        std::thread([]() { ZoneTrace zone("court"); }).join();
+    }
+    Trace::activer(false);
+    Trace::ecrire(chemin);
+    std::ifstream successifs(chemin);
+    int courts = 0;
+    while (std::getline(successifs, ligne))
+    {
+        courts += ligne.find("\"name\": \"court\", \"ph\": \"B\"") != std::string::npos;
+    }
+    successifs.close();
+    std::remove(chemin.c_str());
+    verifier(Trace::getNbTampons() <= tampons + 1, "Trace, tampons des threads terminés réutilisés", Trace::getNbTampons());
+    verifier(courts == 50, "Trace, événements des threads terminés conservés", courts);
+    Trace::reinitialiser();
+}
+
+/**
+ * @brief Teste les options à barrière contre la formule de Reiner et Rubinstein, en surveillance continue puis discrète
+ */
+void test_barriere()
+{
+    // Surveillance continue : la grille ne couvre que la région vivante, [0, 120] ou [80, 300]
+    OptionBarriere put_haut(false, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2);
+    OptionBarriere call_bas(true, TypeBarriere::Basse, 80, 100, 1, 300, 0.05, 0.2);
+    for (const OptionBarriere* option : {&put_haut, &call_bas})
+    {
+        auto maillage = maillageBarriere(*option, 200, 500);
+        EDPComplete edp(*option);
+        std::vector<std::vector<double>> C;
+        CrankNicholson(edp, maillage).solve(C);
+        double erreur = 0;
+        for (double S0 : {90.0, 100.0, 110.0})
+        {
+            erreur = std::max(erreur, std::abs(maillage->interpoler(C[0], S0) - option->prixAnalytique(S0, 0)));
+        }
+        const std::vector<double>& S = maillage->getActif();
+        bool domaine = S.front() == option->getBorneInferieure() && S.back() == option->getL() && S.back() - S.front() < 300;
+        std::string nom = option->estCall() ? "Call à barrière basse" : "Put à barrière haute";
+        verifier(domaine && erreur < 1e-3, nom + " surveillé en continu contre Reiner Rubinstein", erreur);
+    }
+
+    // Surveillance mensuelle : la barrière est un noeud et les dates des temps du maillage. Le prix est entre celui de la
+    // surveillance continue et celui de l'option européenne, et proche de la correction de Broadie, Glasserman et Kou
+    std::vector<double> dates;
+    for (int k = 1; k <= 12; k++)
+    {
+        dates.push_back(k / 12.0);
+    }
+    OptionBarriere put_mensuel(false, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2, dates);
+    auto maillage = maillageBarriere(put_mensuel, 200, 1000);
+    EDPComplete edp(put_mensuel);
+    std::vector<std::vector<double>> C;
+    CrankNicholson(edp, maillage).solve(C);
+    double prix = maillage->interpoler(C[0], 100);
+    double continu = put_haut.prixAnalytique(100, 0);
+    double europeen = Put(100, 1, 300, 0.05, 0.2).prixAnalytique(100, 0);
+    double erreur = std::abs(prix - put_mensuel.prixAnalytique(100, 0));
+    bool aligne = maillage->getM() % 12 == 0 && std::abs(maillage->getActif()[400] - 120) == 0;
+    verifier(aligne && prix > continu && prix < europeen && erreur < 2e-2, "Put à barrière haute surveillé mensuellement contre Broadie Glasserman Kou", erreur);
+
+    // Les dates de surveillance sont aussi appliquées par la résolution en bloc
+    OptionBarriere call_mensuel(true, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2, dates);
+    std::vector<std::vector<std::vector<double>>> bloc;
+    CrankNicholson(edp, maillage).solve({&put_mensuel, &call_mensuel}, bloc);
+    std::vector<std::vector<double>> seul;
+    EDPComplete edp_call(call_mensuel);
+    CrankNicholson(edp_call, maillage).solve(seul);
+    double ecart = std::max(std::abs(bloc[0][0][400] - C[0][400]), std::abs(bloc[1][0][333] - seul[0][333]));
+    verifier(ecart < 1e-12, "Barrières surveillées en bloc contre résolutions séparées", ecart);
+
+    // Maturité non dyadique et domaine qui n'est pas un multiple du pas : le dernier temps est exactement T et les mailles
+    // d'espace sont uniformes
+    std::vector<double> trimestres;
+    for (int k = 1; k <= 4; k++)
+    {
+        trimestres.push_back(k * 0.7 / 4);
+    }
+    OptionBarriere put_trimestriel(false, TypeBarriere::Haute, 130, 100, 0.7, 300, 0.05, 0.2, trimestres);
+    auto irregulier = maillageBarriere(put_trimestriel, 12, 250);
+    const std::vector<double>& S = irregulier->getActif();
+    double ecart_pas = 0;
+    for (std::size_t j = 0; j + 1 < S.size(); j++)
+    {
+        ecart_pas = std::max(ecart_pas, std::abs(S[j+1] - S[j] - irregulier->getDS()));
+    }
+    EDPComplete edp_trimestriel(put_trimestriel);
+    CrankNicholson(edp_trimestriel, irregulier).solve(C);
+    double prix_trimestriel = irregulier->interpoler(C[0], 100);
+    bool fin = irregulier->getTemps().back() == 0.7 && S.back() >= 300;
+    verifier(fin && ecart_pas < 1e-9, "Barrière discrète, dernier temps à maturité et mailles uniformes", ecart_pas);
+    double erreur_trimestriel = std::abs(prix_trimestriel - put_trimestriel.prixAnalytique(100, 0));
+    verifier(erreur_trimestriel < 5e-2, "Put à barrière trimestrielle de maturité non dyadique contre Broadie Glasserman Kou", erreur_trimestriel);
+
+    // Une barrière hors du domaine ou des dates désordonnées rendent l'option invalide : pas de maillage, payoff et prix NaN
+    std::ostringstream sortie;
+    std::streambuf* ancienneSortie = std::cout.rdbuf(sortie.rdbuf());
+    OptionBarriere hors_domaine(false, TypeBarriere::Haute, 400, 100, 1, 300, 0.05, 0.2);
+    OptionBarriere desordonnee(false, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2, {0.5, 0.25, 1});
+    bool refusees = true;
+    for (const OptionBarriere* option : {&hors_domaine, &desordonnee})
+    {
+        refusees = refusees && !option->estValide() && !maillageBarriere(*option, 100, 100)
+                   && std::isnan(option->payoff(100, 1)) && std::isnan(option->prixAnalytique(100, 0));
+    }
+    std::cout.rdbuf(ancienneSortie);
+    verifier(refusees && put_haut.estValide() && put_mensuel.estValide(), "Barrière invalide refusée", refusees);
+
+    // La formule de Reiner et Rubinstein ne s'applique qu'à coefficients constants
+    OptionBarriere put_courbe(false, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2);
+    put_courbe.setStructureParTermes({0.5, 1}, {0.05, 0.05}, {0.15, 0.3});
+    verifier(std::isnan(put_courbe.prixAnalytique(100, 0)), "Barrière à structure par termes, pas de prix analytique", put_courbe.prixAnalytique(100, 0));
+}
+
+/**
+ * @brief Teste le générateur Philox sur ses vecteurs de référence, la reproductibilité de MonteCarlo quel que soit le nombre de
+ * threads, et son accord avec les solveurs EDP
+ */
+void test_monte_carlo()
+{
+    // Vecteurs de référence de Philox4x32-10 (Salmon et al., Random123) : compteur, clé, sortie attendue
+    struct Reference
+    {
+        std::array<std::uint32_t, 4> compteur;
+        std::uint64_t graine;
+        std::array<std::uint32_t, 4> sortie;
+    };
+    const Reference references[] = {
+        {{0, 0, 0, 0}, 0, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffffffffffff, {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0x299f31d0a4093822, {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}};
+    int nb_faux = 0;
+    for (const Reference& reference : references)
+    {
+        nb_faux += Philox(reference.graine)(reference.compteur) != reference.sortie;
+    }
+    verifier(nb_faux == 0, "Philox4x32-10, vecteurs de référence", nb_faux);
+
+    // Chaque chemin a son propre flux et les sommes sont réduites dans l'ordre des paquets : résultat identique au bit près
+    Put put(100, 1, 300, 0.05, 0.2);
+    MonteCarlo un_thread(put, 100000, 1, 1, 42);
+    MonteCarlo quatre_threads(put, 100000, 1, 4, 42);
+    double prix_un = un_thread.solve(100);
+    double prix_quatre = quatre_threads.solve(100);
+    bool identiques = prix_un == prix_quatre && un_thread.getErreurStandard() == quatre_threads.getErreurStandard();
+    verifier(identiques, "MonteCarlo, même prix sur 1 et 4 threads", std::abs(prix_un - prix_quatre));
+
+    // Put européen contre CrankNicholson, à quelques erreurs standard
+    auto maillage = std::make_shared<const Maillage>(1.0, 200, 300.0, 1000);
+    EDPComplete edp(put);
+    std::vector<std::vector<double>> C;
+    CrankNicholson(edp, maillage).solve(C);
+    MonteCarlo europeen(put, 400000, 1, 4, 7);
+    double ecart = std::abs(europeen.solve(100) - maillage->interpoler(C[0], 100));
+    verifier(ecart < 4 * europeen.getErreurStandard(), "MonteCarlo, put européen contre CrankNicholson (en erreurs standard)",
+             ecart / europeen.getErreurStandard());
+
+    // Put à barrière haute surveillé mensuellement : payoff dépendant du chemin contre la résolution avec dates de surveillance
+    std::vector<double> dates;
+    for (int k = 1; k <= 12; k++)
+    {
+        dates.push_back(k / 12.0);
+    }
+    OptionBarriere barriere(false, TypeBarriere::Haute, 120, 100, 1, 300, 0.05, 0.2, dates);
+    auto maillage_barriere = maillageBarriere(barriere, 240, 1000);
+    EDPComplete edp_barriere(barriere);
+    CrankNicholson(edp_barriere, maillage_barriere).solve(C);
+    MonteCarlo chemins(put, 400000, 12, 4, 7);
+    chemins.setPayoffChemin([](const std::vector<double>& S)
+    {
+        for (std::size_t k = 1; k < S.size(); k++)
+        {
+            if (S[k] >= 120)
+            {
+                return 0.0;
+            }
+        }
+        return std::max(0.0, 100 - S.back());
+    });
+    ecart = std::abs(chemins.solve(100) - maillage_barriere->interpoler(C[0], 100));
+    verifier(ecart < 4 * chemins.getErreurStandard(), "MonteCarlo, put à barrière mensuelle contre CrankNicholson (en erreurs standard)",
+             ecart / chemins.getErreurStandard());
+
+    // Variable de contrôle : le payoff d'un call est estimé avec le put vanille de même strike comme contrôle, très corrélé
+    Call call(100, 1, 300, 0.05, 0.2);
+    auto payoffCall = [](const std::vector<double>& S) { return std::max(0.0, S.back() - 100); };
+    MonteCarlo simple(put, 100000, 1, 4, 11);
+    MonteCarlo controle(put, 100000, 1, 4, 11);
+    simple.setPayoffChemin(payoffCall);
+    controle.setPayoffChemin(payoffCall);
+    bool acceptee = controle.setVariableControle(true);
+    simple.solve(100);
+    ecart = std::abs(controle.solve(100) - call.prixAnalytique(100, 0));
+    verifier(acceptee && ecart < 4 * controle.getErreurStandard(), "MonteCarlo, variable de contrôle contre Black Scholes (en erreurs standard)",
+             ecart / controle.getErreurStandard());
+    verifier(controle.getErreurStandard() < 0.5 * simple.getErreurStandard(), "MonteCarlo, variable de contrôle et erreur standard réduite",
+             controle.getErreurStandard() / simple.getErreurStandard());
+
+    // Le prix analytique d'une barrière n'est pas l'espérance de son payoff à maturité : la variable de contrôle est refusée
+    MonteCarlo sur_barriere(barriere, 1000, 12, 1, 3);
+    std::ostringstream sortie;
+    std::streambuf* ancienneSortie = std::cout.rdbuf(sortie.rdbuf());
+    bool refusee = !sur_barriere.setVariableControle(true);
+    std::cout.rdbuf(ancienneSortie);
+    verifier(refusee && !sortie.str().empty(), "MonteCarlo, variable de contrôle refusée pour une barrière", refusee);
+}
+
+/**
+ * @brief Teste l'aller-retour d'un instantané et le rejet d'un fichier d'une autre version, tronqué ou sans signature
+ */
+void test_instantane()
+{
+    const std::string chemin = "test_solveurs_instantane.bin";
+    auto maillage = std::make_shared<const Maillage>(1.0, 50, 300.0, 300);
+    Put put(100, 1, 300, 0.05, 0.2);
+    Call call(100, 1, 300, 0.05, 0.2);
+    EDPComplete edp(put);
+    std::vector<std::vector<std::vector<double>>> C;
+    CrankNicholson(edp, maillage).solve({&put, &call}, C);
+    bool ecrit = ecrireInstantane(chemin, put, Schema::CrankNicholson, maillage->getTemps(), maillage->getActif(), {"put", "call"}, {&C[0], &C[1]});
+
+    // Les tranches lues dans la projection sont celles qui ont été écrites, au bit près
+    double ecart = 0;
+    {
+        Instantane instantane(chemin);
+        bool entete = ecrit && instantane.estValide() && instantane.getEntete().nbTemps == 51 && instantane.getEntete().nbActif == 301
+                      && instantane.trouverGrille("call") == 1 && instantane.trouverGrille("vega") == -1;
+        for (int k = 0; k < 2 && entete; k++)
+        {
+            for (int i = 0; i <= 50; i++)
+            {
+                for (int j = 0; j <= 300; j++)
+                {
+                    ecart = std::max(ecart, std::abs(instantane.tranche(k, i)[j] - C[k][i][j]));
+                }
+            }
+            ecart = std::max(ecart, std::abs(instantane.interpoler(k, 0, 101) - maillage->interpoler(C[k][0], 101)));
+        }
+        verifier(entete && ecart == 0, "Instantané, aller-retour des grilles", ecart);
+    }
+
+    // Fichiers corrompus : le lecteur les refuse au lieu de lire hors du fichier
+    std::ifstream lecture(chemin, std::ios::binary);
+    std::string octets((std::istreambuf_iterator<char>(lecture)), std::istreambuf_iterator<char>());
+    lecture.close();
+    auto ouvrir = [&](const std::string& contenu)
+    {
+        std::ofstream(chemin, std::ios::binary | std::ios::trunc).write(contenu.data(), contenu.size());
+        return Instantane(chemin).estValide();
+    };
+    std::string autre_version = octets;
+    std::uint32_t version = VERSION_INSTANTANE + 1;
+    std::memcpy(&autre_version[offsetof(EnteteInstantane, version)], &version, sizeof(version));
+    std::string sans_signature = octets;
+    sans_signature[0] = 'X';
+    int nb_acceptes = ouvrir(autre_version) + ouvrir(octets.substr(0, octets.size() - 64)) + ouvrir(sans_signature) + ouvrir(octets.substr(0, 64));
+    std::remove(chemin.c_str());
+    verifier(nb_acceptes == 0, "Instantané, version, troncature et signature refusées", nb_acceptes);
+}
+
+/**
+ * @brief Teste l'étude de convergence : ordre observé sur la diagonale des grilles et recommandation d'une grille rectangulaire
+ */
+void test_convergence()
+{
+    // L'EDP réduite est comparée à sa solution exacte, l'EDP complète au prix de Black Scholes
+    Put reduit(100, 1, 300, 0.05, 2);
+    Put put(100, 1, 300, 0.05, 0.2);
+    for (bool crank_nicholson : {false, true})
+    {
+        std::vector<PointConvergence> points = etudeConvergence(crank_nicholson ? put : reduit, crank_nicholson, 5, 4);
+        const PointConvergence& plus_fin = points.back();
+        int k = recommanderGrille(points, 1e-2);
+        std::string nom = crank_nicholson ? "Crank Nicholson (EDP complète)" : "Implicite (EDP réduite)";
+        verifier(points.size() == 25 && plus_fin.erreur < 1e-2 && plus_fin.ordre > 1.5, "Convergence, ordre observé, " + nom, plus_fin.ordre);
+        verifier(k >= 0 && points[k].M < points[k].N, "Convergence, grille recommandée plus fine en espace qu'en temps, " + nom, k);
+    }
+}
+
+/**
+ * @brief Teste des maturités qui ne sont pas des multiples exacts du pas de temps en virgule flottante (M * (T / M) != T)
+ */
+void test_maturite_non_dyadique()
+{
+    double erreur_max = 0;
+    bool exactes = true;
+    for (auto [T, M] : {std::pair<double, int>{0.1, 3}, {0.1, 6}, {0.7, 12}})
+    {
+        auto maillage = std::make_shared<const Maillage>(T, M, 300.0, 600);
+        Put put(100, T, 300, 0.05, 0.2);
+        EDPComplete edp(put);
+        std::vector<std::vector<double>> C;
+        CrankNicholson(edp, maillage).solve(C);
+        exactes = exactes && maillage->getTemps().back() == T;
+        double exact = put.prixAnalytique(100, 0);
+        erreur_max = std::max(erreur_max, std::abs(maillage->interpoler(C[0], 100) - exact) / exact);
+    }
+    // Avec M = 3, deux des trois pas sont les pas implicites du démarrage : l'erreur relative reste de l'ordre du pourcent
+    verifier(exactes && erreur_max < 3e-2, "Maturités non dyadiques, dernier temps exact et put contre Black Scholes (erreur relative)", erreur_max);
+}
+
+/**
+ * @brief Fonction main des tests
+ * @return 0 si tous les tests sont réussis, 1 sinon
+ */
+int main()
+{
+    test_algoThomas();
+    test_parite_analytique();
+    test_crank_nicholson();
+    test_ordre_crank_nicholson();
+    test_implicite();
+    test_structure_par_termes();
+    test_arene();
+    test_maillage_partage();
+    test_paresseux();
+    test_grille_rectangulaire();
+    test_maturite_non_dyadique();
+    test_serveur();
+    test_scenarios();
+    test_schema_theta();
+    test_fixe();
+    test_tarification();
+    test_adaptatif();
+    test_bloc();
+    test_trace();
+    test_barriere();
+    test_monte_carlo();
+    test_instantane();
+    test_convergence();
+
+    std::cout << std::endl << (nb_echecs == 0 ? "Tous les tests sont réussis" : std::to_string(nb_echecs) + " test(s) échoué(s)") << std::endl;
+    return nb_echecs == 0 ? 0 : 1;
+}